@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng (2005).
+ * Events are kept in three tiers:
+ *  - Top: an unsorted array of the events far in the future,
+ *  - Ladder: up to MAX_RUNGS rungs of buckets; each bucket is an
+ *    unsorted array of the events falling in its time range and each
+ *    rung refines one bucket of the rung above it,
+ *  - Bottom: a sorted array of the earliest events.
+ *
+ * Events are inserted by appending them to the array covering their
+ * timestamp, and are sorted only once they reach the bottom, a bucket
+ * at a time.  A bucket holding more than THRESHOLD events is split
+ * into a new rung rather than sorted.  This gives amortized O(1)
+ * Insert and RemoveNext for the usual event distributions.
+ *
+ * Scheduler::Event records are stored by value in contiguous arrays;
+ * buckets and rungs are recycled, so that once the queue reaches its
+ * steady-state size, Insert and RemoveNext do not allocate memory.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &cancelled);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Maximum number of rungs in the ladder. */
+  static const uint32_t MAX_RUNGS = 8;
+  /** Largest bucket sorted into the bottom rather than split. */
+  static const uint32_t THRESHOLD = 50;
+  /** Maximum number of buckets in a rung. */
+  static const uint32_t MAX_BUCKETS = 65536;
+
+  /** An unsorted array of events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    /** Timestamp of the start of the first bucket. */
+    uint64_t start;
+    /** Duration of a bucket, in dimensionless time units. */
+    uint64_t width;
+    /** Number of buckets in use. */
+    uint32_t nBuckets;
+    /** Index of the first bucket not yet dequeued. */
+    uint32_t current;
+    /** The buckets; may hold more than nBuckets recycled entries. */
+    std::vector<Bucket> buckets;
+  };
+
+  /**
+   * Find the bucket which covers a timestamp in the top or in the
+   * ladder.
+   *
+   * \param [in] ts The timestamp.
+   * \returns The bucket, or 0 if the timestamp belongs to the bottom.
+   */
+  Bucket * FindBucket (uint64_t ts);
+  /**
+   * Insert an event in the sorted bottom.
+   *
+   * \param [in] ev The event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Remove the cancelled events of an unsorted bucket.
+   *
+   * \param [in,out] bucket The bucket.
+   * \param [out] cancelled The removed events are appended to this vector.
+   */
+  void RemoveCancelledFrom (Bucket &bucket, std::vector<Scheduler::Event> &cancelled);
+  /** Refill the bottom when it runs empty. */
+  void Refill (void);
+  /** Move the events of the top to the ladder or to the bottom. */
+  void TransferTop (void);
+  /**
+   * Start a new rung to split a bucket of the deepest rung.
+   *
+   * \param [in,out] bucket The bucket, emptied on return.
+   * \param [in] start Timestamp of the start of the bucket.
+   * \param [in] width Duration of the bucket.
+   */
+  void SpawnRung (Bucket &bucket, uint64_t start, uint64_t width);
+  /**
+   * Prepare a rung.
+   *
+   * \param [in,out] rung The rung.
+   * \param [in] start Timestamp of the start of the first bucket.
+   * \param [in] width Duration of a bucket.
+   * \param [in] nBuckets Number of buckets.
+   */
+  void InitRung (Rung &rung, uint64_t start, uint64_t width, uint32_t nBuckets);
+
+  /** The unsorted events with a timestamp at least m_topStart. */
+  Bucket m_top;
+  /** Smallest timestamp of the events which belong to the top. */
+  uint64_t m_topStart;
+  /** Lower bound of the timestamps in the top. */
+  uint64_t m_topMin;
+  /** Upper bound of the timestamps in the top. */
+  uint64_t m_topMax;
+  /** The rungs; only the first m_nRungs are in use. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The sorted earliest events. */
+  Bucket m_bottom;
+  /** Index of the next event in m_bottom. */
+  uint32_t m_bottomHead;
+  /** Number of events in the queue. */
+  uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
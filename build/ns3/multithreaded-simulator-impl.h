@@ -0,0 +1,343 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <pthread.h>
+#include <list>
+#include <map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Conservative parallel simulator running partitions of the
+ * simulation on a pool of threads sharing one address space.
+ *
+ * Every event context (that is, every node id) is mapped to a
+ * partition.  Each partition owns its own event list, clock and
+ * event uid counter.  By default context \c c is mapped to partition
+ * <tt>c % PartitionCount</tt>; SetPartition() installs a user-supplied
+ * mapping.  Events without a context are run by partition 0.
+ *
+ * The simulation advances in time windows.  At the start of a window
+ * the smallest pending timestamp \c t over all partitions is found
+ * and every partition independently runs its events with a timestamp
+ * lower than <tt>t + LookAhead</tt>.  Events scheduled for a context
+ * which belongs to another partition are not serialized: the EventImpl
+ * (and hence any Ptr<Packet> bound into it) is queued in an outbox of
+ * the sending partition and handed to its destination partition at
+ * the next window boundary.  Outboxes are drained in partition order
+ * so that a run is reproducible whatever the number of threads.
+ *
+ * The lookahead must be a lower bound on the delay of any event
+ * scheduled across partitions, typically the smallest propagation
+ * delay of the channels joining two partitions, as computed for
+ * DistributedSimulatorImpl.  It can be set directly with SetLookAhead()
+ * or with the "LookAhead" attribute; MultithreadedPartitionHelper
+ * derives both the partition map and the lookahead from the
+ * point-to-point channels of the topology.  Scheduling a cross
+ * partition event with a delay smaller than the lookahead is a fatal
+ * error.
+ *
+ * Thread safety: models executed by different partitions run
+ * concurrently.  Objects shared between partitions (for example a
+ * channel, or a device referenced by an event bound for a remote
+ * node) must only be read from events of a foreign partition, since
+ * the reference counts of Ptr and SimpleRefCount are not atomic.  A
+ * point-to-point link satisfies this as long as the lookahead does not
+ * exceed its delay: the sending side drops its last reference to the
+ * packet at the end of the transmission, which is always processed in
+ * an earlier window than the reception.
+ *
+ * Simulator::Stop() called from an event stops its partition
+ * immediately, and the whole simulation at the end of the current
+ * window.  Simulator::Stop(const Time&) takes effect immediately in
+ * the calling partition and at the next window boundary in the other
+ * ones; events with a timestamp up to and including the stop time are
+ * executed.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &delay);
+  virtual EventId Schedule (Time const &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * Assign a context (a node id) to a partition.
+   *
+   * Contexts which were never assigned fall back to
+   * <tt>context % PartitionCount</tt>.  The partition map cannot be
+   * changed once Run() has been called.
+   *
+   * \param [in] context The context.
+   * \param [in] partition The partition index, lower than
+   *             the partition count.
+   */
+  void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * Get the partition which runs the events of a context.
+   *
+   * \param [in] context The context.
+   * \returns The partition index.
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * Set the number of partitions.
+   *
+   * \param [in] count The number of partitions; zero selects
+   *             the number of worker threads.
+   */
+  void SetPartitionCount (uint32_t count);
+  /**
+   * \returns The number of partitions.
+   */
+  uint32_t GetPartitionCount (void) const;
+  /**
+   * Set the number of threads, including the main thread, which
+   * process partitions.
+   *
+   * \param [in] count The number of threads; zero selects the number
+   *             of online processors.
+   */
+  void SetThreadCount (uint32_t count);
+  /**
+   * \returns The number of threads which process partitions.
+   */
+  uint32_t GetThreadCount (void) const;
+  /**
+   * Set the lookahead, that is the smallest delay of any event
+   * scheduled from one partition to another.
+   *
+   * \param [in] lookAhead The lookahead.
+   */
+  void SetLookAhead (const Time &lookAhead);
+  /**
+   * \returns The lookahead.
+   */
+  Time GetLookAhead (void) const;
+  /**
+   * \returns The number of time windows executed so far.
+   */
+  uint64_t GetWindowCount (void) const;
+  /**
+   * \returns The number of events handed from one partition to
+   *          another so far.
+   */
+  uint64_t GetRemoteEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event scheduled from one partition for another. */
+  struct RemoteEvent
+  {
+    /** The event timestamp. */
+    uint64_t timestamp;
+    /** The event context. */
+    uint32_t context;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /** Container of the events sent from one partition to another. */
+  typedef std::vector<RemoteEvent> RemoteEvents;
+
+  /** The state owned by a partition. */
+  struct Partition
+  {
+    /** Index of this partition. */
+    uint32_t index;
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /** Next event unique id. */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** Execution context of the current event. */
+    uint32_t currentContext;
+    /** Number of events inserted in this partition but not yet run. */
+    int unscheduledEvents;
+    /** Stop requested by an event of this partition. */
+    bool stop;
+    /** Stop time requested by an event of this partition. */
+    uint64_t stopTs;
+    /** Number of events received from other partitions. */
+    uint64_t remoteEvents;
+    /** Outgoing events, indexed by destination partition. */
+    std::vector<RemoteEvents> outbox;
+  };
+
+  /** The work a thread is asked to do on each partition. */
+  enum Phase
+  {
+    PHASE_EXECUTE,   /**< Run the events of the current window. */
+    PHASE_RECEIVE,   /**< Insert the events received from other partitions. */
+    PHASE_EXIT       /**< Terminate the worker threads. */
+  };
+
+  /**
+   * Get the partition the calling thread is currently running.
+   * \returns The partition, or 0 when called outside of an event.
+   */
+  Partition * PeekCurrentPartition (void) const;
+  /**
+   * Get the partition which owns an event.
+   * \param [in] context The event context.
+   * \returns The partition.
+   */
+  Partition * PeekPartition (uint32_t context) const;
+  /** Create the partitions and move the pending events into them. */
+  void SetupPartitions (void);
+  /**
+   * Allocate a uid for an event scheduled from outside of the partitions.
+   * \param [in] context The event context.
+   * \returns The uid.
+   */
+  uint32_t AllocateUid (uint32_t context);
+  /**
+   * Insert an event in the partition which owns its context.
+   * \param [in] ev The event.
+   */
+  void Insert (const Scheduler::Event &ev);
+  /**
+   * Run the events of a partition up to the end of the current window.
+   * \param [in] partition The partition.
+   */
+  void ExecutePartition (Partition *partition);
+  /**
+   * Insert in a partition the events sent by the other partitions
+   * during the last window.
+   * \param [in] partition The partition.
+   */
+  void ReceivePartition (Partition *partition);
+  /**
+   * Have all threads run a phase over every partition and wait for
+   * them to complete it.
+   * \param [in] phase The phase.
+   */
+  void Dispatch (enum Phase phase);
+  /** Grab and process partitions until none is left in this phase. */
+  void DoPhase (void);
+  /** Entry point of the worker threads. */
+  void WorkerLoop (void);
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Events scheduled before the partitions are created. */
+  Ptr<Scheduler> m_events;
+  /** Factory used to create the per-partition schedulers. */
+  ObjectFactory m_schedulerFactory;
+  /** The partitions, created on the first call to Run(). */
+  std::vector<Partition *> m_partitions;
+  /** User-supplied context to partition map. */
+  std::map<uint32_t, uint32_t> m_partitionMap;
+  /** Partition of each context, flattened from m_partitionMap. */
+  std::vector<uint32_t> m_contextPartition;
+  /** Number of partitions. */
+  uint32_t m_partitionCount;
+  /** Number of threads processing partitions. */
+  uint32_t m_threadCount;
+  /** The lookahead, in time steps. */
+  Time m_lookAhead;
+
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** Absolute time at which the simulation stops. */
+  uint64_t m_stopTs;
+  /** Next event unique id, outside of the partitions. */
+  uint32_t m_uid;
+  /** Simulation time seen from outside of the partitions. */
+  uint64_t m_currentTs;
+  /** Number of events inserted before the partitions are created. */
+  int m_unscheduledEvents;
+  /** Exclusive end of the current window. */
+  uint64_t m_windowEnd;
+  /** Number of windows executed. */
+  uint64_t m_windowCount;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+  /** Worker threads. */
+  std::vector<Ptr<SystemThread> > m_workers;
+  /** Key of the thread-specific current partition. */
+  pthread_key_t m_currentPartition;
+  /** Protects the phase dispatch state below. */
+  pthread_mutex_t m_mutex;
+  /** Signalled when a new phase is dispatched. */
+  pthread_cond_t m_phaseStart;
+  /** Signalled when the last worker completes a phase. */
+  pthread_cond_t m_phaseDone;
+  /** The current phase. */
+  enum Phase m_phase;
+  /** Incremented at every dispatch. */
+  uint64_t m_generation;
+  /** Next partition to grab in the current phase. */
+  uint32_t m_nextPartition;
+  /** Number of workers still busy with the current phase. */
+  uint32_t m_busyWorkers;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+#ifndef PACKET_TAG_LIST_H
+#define PACKET_TAG_LIST_H
+
+/**
+\file   packet-tag-list.h
+\brief  Defines a copy-on-write array of Packet tags.
+*/
+
+#include <stdint.h>
+#include <ostream>
+#include "ns3/type-id.h"
+#include "data-cache.h"
+
+namespace ns3 {
+
+class Tag;
+
+/**
+ * \ingroup packet
+ *
+ * \brief List of the packet tags stored in a packet.
+ *
+ * This class is mostly private to the Packet implementation and users
+ * should never have to access it directly.
+ *
+ * \internal
+ *
+ *   - Tags are stored in serialized form in an array of TagData,
+ *     held in a single, reference-counted Data block, in the order in
+ *     which they were added.  An empty list holds no block at all.
+ *
+ *   - The few tags of a packet are found by a linear scan of the
+ *     array, which is contiguous in memory.
+ *
+ * \par <b> Copy-on-write </b> is implemented as follows:
+ *
+ *   - Copy constructor (PacketTagList(const PacketTagList & o))
+ *     and assignment (#operator=(const PacketTagList & o))
+ *     simply share the block of the original PacketTagList \c o,
+ *     incrementing its \c m_count.
+ *
+ *   - #Add, #Remove and #Replace write to the block in place if it is
+ *     not shared.  Otherwise, they copy all its tags in a new block
+ *     with a single memcpy, and leave the shared block to the other
+ *     lists.  Since #Add does not change the tags seen by the other
+ *     lists, it is a \c const function.
+ *
+ * \par <b> Memory Management: </b>
+ * \n
+ * Packet tags must serialize to a finite maximum size, see TagData.
+ * The blocks are recycled through a DataCache, see GetCacheStats.
+ */
+class PacketTagList 
+{
+public:
+  /**
+   * Serialized tag.
+   *
+   * See TagData::TagData_e for a discussion of the size limit on
+   * tag serialization.
+   */
+  struct TagData
+  {
+    /**
+     * \brief Packet Tag maximum size
+     *
+     * The maximum size (in bytes) of a Tag is stored
+     * in this constant.
+     *
+     * \internal
+     * ns3:Ipv6PacketInfoTag needs 19 bytes.  The current implementation
+     * allows 21 bytes, which, with the \c #tid, gives TagData a size of
+     * 24 bytes on all architectures.
+     */
+    enum TagData_e
+    {
+      MAX_SIZE = 21           /**< Size of serialization buffer #data */
+  };
+
+    uint8_t data[MAX_SIZE];   /**< Serialization buffer */
+    TypeId tid;               /**< Type of the tag serialized into #data */
+  };  /* struct TagData */
+
+  /**
+   * Create a new PacketTagList.
+   */
+  inline PacketTagList ();
+  /**
+   * Copy constructor
+   *
+   * \param [in] o The PacketTagList to copy.
+   *
+   * This makes a light-weight copy, which shares the tags
+   * of \pname{o}.
+   */
+  inline PacketTagList (PacketTagList const &o);
+  /**
+   * Assignment
+   *
+   * \param [in] o The PacketTagList to copy.
+   * \returns the copied object
+   *
+   * This makes a light-weight copy by #RemoveAll, then
+   * sharing the tags of \pname{o}.
+   */
+  inline PacketTagList &operator = (PacketTagList const &o);
+  /**
+   * Destructor
+   *
+   * #RemoveAll's the tags.
+   */
+  inline ~PacketTagList ();
+
+  /**
+   * Add a tag at the end of this list.
+   *
+   * \param [in] tag The tag to add
+   */
+  void Add (Tag const&tag) const;
+  /**
+   * Remove (the first instance of) tag from the list.
+   *
+   * \param [in,out] tag The tag type to remove.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Remove (Tag &tag);
+  /**
+   * Replace the value of a tag.
+   *
+   * \param [in] tag The tag type to replace.  To get the old
+   *        value of the tag, use #Peek first.
+   * \returns True if \pname{tag} is found, false otherwise.
+   *        If \pname{tag} wasn't found, Add is performed instead (so
+   *        the list is guaranteed to have the new tag value either way).
+   */
+  bool Replace (Tag &tag);
+  /**
+   * Find a tag and return its value.
+   *
+   * \param [in,out] tag The tag type to find.  If found,
+   *          \pname{tag} is set to the value of the tag found.
+   * \returns True if \pname{tag} is found, false otherwise.
+   */
+  bool Peek (Tag &tag) const;
+  /**
+   * Remove all tags from this list.
+   */
+  inline void RemoveAll (void);
+  /**
+   * \returns pointer to the array of the tags, in the order in which
+   *          they were added, or zero if the list is empty
+   */
+  inline const struct PacketTagList::TagData *GetTags (void) const;
+  /**
+   * \returns the number of tags in the list
+   */
+  inline uint32_t GetNTags (void) const;
+
+  /**
+   * Get the statistics of the cache of the tag arrays.
+   *
+   * \returns The statistics, summed over all threads.
+   */
+  static DataCache::Stats GetCacheStats (void);
+
+private:
+  /**
+   * The reference-counted block which holds the tags.
+   */
+  struct Data
+  {
+    uint32_t m_count;     /**< Number of PacketTagList's sharing the block */
+    uint16_t m_capacity;  /**< Number of TagData which fit in the block */
+    uint16_t m_size;      /**< Number of TagData in use */
+    /**
+     * The tags: the block is allocated with room for \c m_capacity
+     * of them.
+     */
+    struct TagData m_tags[1];
+  };
+
+  /** Number of tags of the first block of a list. */
+  static const uint32_t INITIAL_CAPACITY = 4;
+
+  /**
+   * Allocate a block, from the cache if possible.
+   *
+   * \param [in] capacity The minimum number of tags of the block.
+   * \returns The block, with a single reference and no tag.
+   */
+  static struct Data *Allocate (uint32_t capacity);
+  /**
+   * Release a block which is no longer referenced to the cache.
+   *
+   * \param [in] data The block.
+   */
+  static void Recycle (struct Data *data);
+  /**
+   * Make sure that this list owns its block, which has room
+   * for \pname{capacity} tags, copying the tags to a new block if needed.
+   *
+   * \param [in] capacity The number of tags the block must hold.
+   */
+  void Reserve (uint32_t capacity);
+  /**
+   * Find a tag.
+   *
+   * \param [in] tid The tag type to find.
+   * \returns The index of the tag in the array, or -1 if it is not found.
+   */
+  int32_t Find (TypeId tid) const;
+
+  static uint32_t m_maxCapacity; //!< Capacity of the largest block allocated
+
+  /**
+   * The block of the tags, or zero if the list is empty
+   */
+  struct Data *m_data;
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3 {
+
+PacketTagList::PacketTagList ()
+  : m_data (0)
+{
+}
+
+PacketTagList::PacketTagList (PacketTagList const &o)
+  : m_data (o.m_data)
+{
+  if (m_data != 0)
+    {
+      m_data->m_count++;
+    }
+}
+
+PacketTagList &
+PacketTagList::operator = (PacketTagList const &o)
+{
+  // self assignment
+  if (m_data == o.m_data) 
+    {
+      return *this;
+    }
+  RemoveAll ();
+  m_data = o.m_data;
+  if (m_data != 0) 
+    {
+      m_data->m_count++;
+    }
+  return *this;
+}
+
+PacketTagList::~PacketTagList ()
+{
+  RemoveAll ();
+}
+
+void
+PacketTagList::RemoveAll (void)
+{
+  if (m_data != 0)
+    {
+      m_data->m_count--;
+      if (m_data->m_count == 0)
+        {
+          Recycle (m_data);
+        }
+      m_data = 0;
+    }
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::GetTags (void) const
+{
+  return m_data != 0 ? m_data->m_tags : 0;
+}
+
+uint32_t
+PacketTagList::GetNTags (void) const
+{
+  return m_data != 0 ? m_data->m_size : 0;
+}
+
+} // namespace ns3
+
+#endif /* PACKET_TAG_LIST_H */
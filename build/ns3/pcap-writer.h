@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_WRITER_H
+#define PCAP_WRITER_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Packet;
+class Header;
+
+/**
+ * \brief A writer of pcap or pcapng files, which buffers the records
+ * in large blocks.
+ *
+ * The records are encoded in a block of memory, which is written
+ * to the file once it is full.  In asynchronous mode, the full blocks
+ * are handed over to a background thread, which writes them while the
+ * simulation goes on; at most MAX_PENDING_BLOCKS blocks wait for
+ * that thread, after which Write waits for it.  The file can also be
+ * compressed on the fly with gzip, if zlib was found at configure time.
+ *
+ * The pcap files are written in little endian order, like those of
+ * PcapFile, so that both classes write the same bytes for the same
+ * records.  The pcapng files hold a single section with a single
+ * interface, and one enhanced packet block per record.
+ *
+ * This class is used by PcapFileWrapper, according to its Asynchronous,
+ * Format and Compression attributes.
+ */
+class PcapWriter
+{
+public:
+  /** The file formats. */
+  enum Format
+  {
+    PCAP,    //!< The classic libpcap format
+    PCAPNG   //!< The pcap next generation format
+  };
+  /** The compression of the files. */
+  enum Compression
+  {
+    NONE,    //!< No compression
+    GZIP     //!< gzip compression, if zlib is available
+  };
+
+  /** The maximum number of full blocks waiting for the writer thread. */
+  static const uint32_t MAX_PENDING_BLOCKS = 4;
+
+  /**
+   * Constructor.
+   *
+   * \param format The file format.
+   * \param compression The compression of the file.
+   * \param blockSize The size of the blocks of records, in bytes.
+   * \param async Whether the blocks are written by a background thread.
+   *        Ignored if threads are not supported.
+   */
+  PcapWriter (enum Format format, enum Compression compression,
+              uint32_t blockSize, bool async);
+  /** Destructor: close the file. */
+  ~PcapWriter ();
+
+  /**
+   * \returns true if the file could not be opened or written.
+   */
+  bool Fail (void) const;
+  /**
+   * \brief Create a file, and start the writer thread in asynchronous mode.
+   * \param filename The name of the file.
+   */
+  void Open (std::string const &filename);
+  /**
+   * \brief Write the records which are still buffered, stop the writer
+   * thread and close the file.
+   */
+  void Close (void);
+  /**
+   * \brief Write the records which are still buffered to the file.
+   *
+   * In asynchronous mode, wait until the writer thread has written them.
+   */
+  void Flush (void);
+
+  /**
+   * \brief Write the file header.
+   * \param dataLinkType The data link type of the records.
+   * \param snapLen The maximum number of bytes of each record.
+   * \param timeZoneCorrection The time zone offset of the timestamps,
+   *        which only the pcap format records.
+   * \param nanosecMode Whether the timestamps are in nanoseconds, rather
+   *        than microseconds.
+   */
+  void Init (uint32_t dataLinkType, uint32_t snapLen,
+             int32_t timeZoneCorrection, bool nanosecMode);
+
+  /**
+   * \brief Write a record
+   * \param tsSec Packet timestamp, seconds
+   * \param tsFrac Packet timestamp, microseconds or nanoseconds
+   * \param data Data buffer
+   * \param totalLen Total packet length
+   */
+  void Write (uint32_t tsSec, uint32_t tsFrac, uint8_t const *data, uint32_t totalLen);
+  /**
+   * \brief Write a record
+   * \param tsSec Packet timestamp, seconds
+   * \param tsFrac Packet timestamp, microseconds or nanoseconds
+   * \param p Packet to write
+   */
+  void Write (uint32_t tsSec, uint32_t tsFrac, Ptr<const Packet> p);
+  /**
+   * \brief Write a record
+   * \param tsSec Packet timestamp, seconds
+   * \param tsFrac Packet timestamp, microseconds or nanoseconds
+   * \param header Header to write, in front of packet
+   * \param p Packet to write
+   */
+  void Write (uint32_t tsSec, uint32_t tsFrac, const Header &header, Ptr<const Packet> p);
+
+  /** \returns Whether the timestamps are in nanoseconds. */
+  bool IsNanoSecMode (void) const;
+  /**
+   * \returns The pcap magic number, or the byte order magic of the
+   *          section header block of a pcapng file.
+   */
+  uint32_t GetMagic (void) const;
+  /** \returns The major version of the file format. */
+  uint16_t GetVersionMajor (void) const;
+  /** \returns The minor version of the file format. */
+  uint16_t GetVersionMinor (void) const;
+  /** \returns The time zone offset. */
+  int32_t GetTimeZoneOffset (void) const;
+  /** \returns The snap length. */
+  uint32_t GetSnapLen (void) const;
+  /** \returns The data link type. */
+  uint32_t GetDataLinkType (void) const;
+
+private:
+  /**
+   * \brief Start a record in the current block.
+   * \param tsSec Packet timestamp, seconds
+   * \param tsFrac Packet timestamp, microseconds or nanoseconds
+   * \param totalLen Total packet length
+   * \returns The number of bytes of the packet to write in the record.
+   */
+  uint32_t WriteRecordHeader (uint32_t tsSec, uint32_t tsFrac, uint32_t totalLen);
+  /**
+   * \brief End a record in the current block, and hand the block over
+   * if it is full.
+   * \param inclLen The number of bytes of the packet in the record.
+   */
+  void WriteRecordTrailer (uint32_t inclLen);
+  /**
+   * \brief Reserve room at the end of the current block.
+   * \param size The number of bytes.
+   * \returns The reserved bytes.
+   */
+  uint8_t * Reserve (uint32_t size);
+  /**
+   * \brief Append a value to the current block, in little endian order.
+   * \param value The value.
+   */
+  void WriteU16 (uint16_t value);
+  /**
+   * \brief Append a value to the current block, in little endian order.
+   * \param value The value.
+   */
+  void WriteU32 (uint32_t value);
+  /**
+   * \brief Write the current block, or hand it over to the writer thread.
+   */
+  void HandOver (void);
+  /**
+   * \brief Write a block to the file.
+   * \param block The block.
+   * \returns true if the whole block was written.
+   */
+  bool WriteBlock (const std::vector<uint8_t> &block);
+  /** The main loop of the writer thread. */
+  void Run (void);
+
+  /**
+   * Copy constructor: not implemented.
+   * \param o The writer.
+   */
+  PcapWriter (const PcapWriter &o);
+  /**
+   * Assignment: not implemented.
+   * \param o The writer.
+   * \returns This writer.
+   */
+  PcapWriter & operator = (const PcapWriter &o);
+
+  struct Sync;
+
+  enum Format m_format;            //!< The file format
+  enum Compression m_compression;  //!< The compression of the file
+  uint32_t m_blockSize;            //!< The size of the blocks
+  bool m_async;                    //!< Whether a thread writes the blocks
+  bool m_failed;                   //!< Whether the file could not be opened or written
+  bool m_nanosecMode;              //!< Timestamps in nanoseconds
+  int32_t m_zone;                  //!< Time zone offset
+  uint32_t m_snapLen;              //!< Maximum size of the records
+  uint32_t m_dataLinkType;         //!< Data link type
+  void *m_file;                    //!< The FILE or gzFile of the file, or 0
+  std::vector<uint8_t> *m_block;   //!< The block being filled
+  uint32_t m_recordStart;          //!< Start of the current record in the block
+  std::list<std::vector<uint8_t> *> m_pending; //!< The full blocks, oldest first
+  std::vector<std::vector<uint8_t> *> m_free;  //!< The blocks which can be reused
+  bool m_writing;                  //!< Whether the thread is writing a block
+  bool m_closing;                  //!< Whether the thread should exit
+  Sync *m_sync;                    //!< The writer thread and its synchronization, or 0
+};
+
+} // namespace ns3
+
+#endif /* PCAP_WRITER_H */
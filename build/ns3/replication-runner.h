@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef REPLICATION_RUNNER_H
+#define REPLICATION_RUNNER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Run the independent replications of a simulation in
+ * parallel worker processes.
+ *
+ * The topology is built once; Fork() then forks one worker process
+ * per replication, each with its own run number (see
+ * RngSeedManager::SetRun), with at most one worker per processor
+ * running at a time.  The random variable streams created before the
+ * fork are reseeded in each worker, so that a worker draws the same
+ * numbers as a program started with the same run number.
+ *
+ * Each worker writes its results to the files named by
+ * GetOutputFilename; once all the workers have exited, the parent
+ * merges the files of each output declared with AddOutput, in run
+ * order, and removes them.
+ *
+ * \code
+ *   // ... build the topology, install the FlowMonitor ...
+ *   ReplicationRunner runner;
+ *   runner.SetRuns (1, 30);
+ *   runner.AddOutput ("flows.xml", ReplicationRunner::XML);
+ *   if (runner.Fork ())
+ *     {
+ *       // in a worker process
+ *       Simulator::Stop (Seconds (100));
+ *       Simulator::Run ();
+ *       monitor->SerializeToXmlFile (runner.GetOutputFilename ("flows.xml"), true, true);
+ *       Simulator::Destroy ();
+ *       runner.Exit ();
+ *     }
+ *   // in the parent: flows.xml holds the results of the 30 runs
+ * \endcode
+ *
+ * The simulation must run in a single thread: fork() copies only the
+ * calling thread.
+ */
+class ReplicationRunner
+{
+public:
+  /** How the files of the workers are merged. */
+  enum MergeMode
+  {
+    /** Concatenate the files, for instance text or CSV outputs. */
+    CONCATENATE,
+    /**
+     * Wrap each XML document in a \c Replication element with a \c run
+     * attribute, under a \c Replications root element.
+     */
+    XML
+  };
+
+  ReplicationRunner ();
+
+  /**
+   * \param [in] first The run number of the first replication.
+   * \param [in] count The number of replications.
+   */
+  void SetRuns (uint64_t first, uint32_t count);
+  /**
+   * \param [in] count The maximum number of workers running at the
+   * same time; zero, the default, uses the number of processors.
+   */
+  void SetMaxProcesses (uint32_t count);
+  /**
+   * Declare a file written by each worker.
+   *
+   * \param [in] filename The name of the merged file.
+   * \param [in] mode How to merge the files of the workers.
+   */
+  void AddOutput (std::string filename, enum MergeMode mode);
+  /**
+   * Fork the workers.
+   *
+   * \returns \c true in the worker processes.  In the parent,
+   * returns \c false once all the workers have exited and their
+   * outputs have been merged.
+   */
+  bool Fork (void);
+  /**
+   * \returns The run number of this worker.
+   */
+  uint64_t GetRun (void) const;
+  /**
+   * \param [in] filename The name of an output declared with AddOutput.
+   * \returns The name of the file this worker should write.
+   */
+  std::string GetOutputFilename (std::string filename) const;
+  /**
+   * Terminate this worker, without running the destructors of the
+   * static objects, which belong to the parent process.
+   *
+   * \param [in] status The exit status; non-zero reports a failure.
+   */
+  void Exit (int status = 0);
+  /**
+   * \returns The number of workers which failed, or did not write
+   * all their outputs.
+   */
+  uint32_t GetFailures (void) const;
+
+private:
+  /** An output of the workers. */
+  struct Output
+  {
+    std::string filename;  //!< Name of the merged file
+    enum MergeMode mode;   //!< How to merge the files
+  };
+
+  /**
+   * \param [in] filename The name of an output.
+   * \param [in] run A run number.
+   * \returns The name of the file of the worker.
+   */
+  static std::string GetWorkerFilename (std::string filename, uint64_t run);
+  /**
+   * Merge the files of an output and remove them.
+   *
+   * \param [in] output The output.
+   * \param [in,out] failed Set for the replications whose file is missing.
+   */
+  void Merge (const Output &output, std::vector<bool> &failed) const;
+
+  uint64_t m_firstRun;             //!< Run number of the first replication
+  uint32_t m_runs;                 //!< Number of replications
+  uint32_t m_maxProcesses;         //!< Maximum number of running workers
+  std::vector<Output> m_outputs;   //!< The outputs to merge
+  bool m_worker;                   //!< \c true in the workers
+  uint64_t m_run;                  //!< Run number of this worker
+  uint32_t m_failures;             //!< Number of failed workers
+};
+
+} // namespace ns3
+
+#endif /* REPLICATION_RUNNER_H */
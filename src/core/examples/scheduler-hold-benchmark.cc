@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Compare the event schedulers with the classic hold model.
+ *
+ * The queue is first filled with \c population events.  Each hold
+ * operation then removes the earliest event and inserts a new one at
+ * the time of the removed event plus an exponentially distributed
+ * increment, which keeps the queue size constant.  The schedulers are
+ * driven directly, without the simulator, so that only the cost of
+ * the queue itself is measured.
+ *
+ * \code
+ *   ./waf --run "scheduler-hold-benchmark --minPopulation=10000 --maxPopulation=10000000"
+ * \endcode
+ */
+
+using namespace ns3;
+
+/** Number of precomputed timestamp increments. */
+static const uint32_t INCREMENTS = 1 << 16;
+
+/**
+ * Run the hold model on one scheduler.
+ *
+ * \param [in] type The scheduler TypeId name.
+ * \param [in] population The number of pending events.
+ * \param [in] holds The number of hold operations.
+ * \param [in] increments The timestamp increments to cycle through.
+ */
+static void
+RunHold (std::string type, uint32_t population, uint32_t holds,
+         const std::vector<uint64_t> &increments)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+  uint32_t uid = 0;
+  uint32_t next = 0;
+  SystemWallClockMs clock;
+
+  clock.Start ();
+  for (uint32_t i = 0; i < population; i++)
+    {
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key.m_ts = increments[next++ % INCREMENTS];
+      ev.key.m_uid = uid++;
+      ev.key.m_context = 0;
+      scheduler->Insert (ev);
+    }
+  int64_t init = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < holds; i++)
+    {
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      ev.key.m_ts += increments[next++ % INCREMENTS];
+      ev.key.m_uid = uid++;
+      scheduler->Insert (ev);
+    }
+  int64_t hold = clock.End ();
+
+  while (!scheduler->IsEmpty ())
+    {
+      scheduler->RemoveNext ();
+    }
+
+  std::cout << std::left << std::setw (22) << type
+            << std::right << std::setw (10) << population
+            << std::setw (12) << init
+            << std::setw (12) << hold
+            << std::setw (12) << std::fixed << std::setprecision (1)
+            << (holds > 0 ? hold * 1e6 / holds : 0.0)
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minPopulation = 10000;
+  uint32_t maxPopulation = 10000000;
+  uint32_t holds = 1000000;
+  uint32_t listLimit = 10000;
+  double mean = 100;
+  std::string schedulers = "ns3::ListScheduler,ns3::MapScheduler,ns3::HeapScheduler,"
+    "ns3::CalendarScheduler,ns3::LadderScheduler";
+
+  CommandLine cmd;
+  cmd.AddValue ("minPopulation", "Smallest number of pending events", minPopulation);
+  cmd.AddValue ("maxPopulation", "Largest number of pending events; the population grows tenfold from minPopulation", maxPopulation);
+  cmd.AddValue ("holds", "Number of hold operations per run", holds);
+  cmd.AddValue ("listLimit", "Largest population to run the ListScheduler with", listLimit);
+  cmd.AddValue ("mean", "Mean timestamp increment, in time steps", mean);
+  cmd.AddValue ("schedulers", "Comma-separated list of schedulers to compare", schedulers);
+  cmd.Parse (argc, argv);
+
+  std::vector<std::string> types;
+  std::string::size_type start = 0;
+  while (start <= schedulers.size ())
+    {
+      std::string::size_type end = schedulers.find (',', start);
+      if (end == std::string::npos)
+        {
+          end = schedulers.size ();
+        }
+      if (end > start)
+        {
+          types.push_back (schedulers.substr (start, end - start));
+        }
+      start = end + 1;
+    }
+
+  Ptr<ExponentialRandomVariable> random = CreateObject<ExponentialRandomVariable> ();
+  random->SetAttribute ("Mean", DoubleValue (mean));
+  random->SetStream (1);
+  std::vector<uint64_t> increments (INCREMENTS);
+  for (uint32_t i = 0; i < INCREMENTS; i++)
+    {
+      increments[i] = random->GetInteger ();
+    }
+
+  std::cout << std::left << std::setw (22) << "scheduler"
+            << std::right << std::setw (10) << "events"
+            << std::setw (12) << "init (ms)"
+            << std::setw (12) << "hold (ms)"
+            << std::setw (12) << "ns/hold"
+            << std::endl;
+
+  for (uint64_t population = minPopulation; population <= maxPopulation; population *= 10)
+    {
+      for (std::vector<std::string>::const_iterator i = types.begin (); i != types.end (); ++i)
+        {
+          if (*i == "ns3::ListScheduler" && population > listLimit)
+            {
+              continue;
+            }
+          RunHold (*i, population, holds, increments);
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+/**
+ * \file
+ * \ingroup time
+ * Compare the common Time conversions with the equivalent int64x64_t
+ * multiply and divide.
+ *
+ * Each operation is run on the same set of values: Seconds() and
+ * MilliSeconds() against Time::From() with an int64x64_t, and
+ * Time::GetSeconds() and Time::GetMilliSeconds() against Time::To().
+ * With the default nanosecond resolution the former use inline integer
+ * arithmetic; after \c --resolution=PS both take the general path.
+ *
+ * \code
+ *   ./waf --run "time-benchmark --operations=10000000"
+ * \endcode
+ */
+
+using namespace ns3;
+
+/** Number of precomputed values. */
+static const uint32_t VALUES = 1 << 12;
+
+/**
+ * Print the result of one measure.
+ *
+ * \param [in] name The operation.
+ * \param [in] ms The run time, in milliseconds.
+ * \param [in] operations The number of operations.
+ * \param [in] reference The run time of the reference operation, in milliseconds.
+ */
+static void
+Report (std::string name, int64_t ms, uint32_t operations, int64_t reference)
+{
+  std::cout << std::left << std::setw (34) << name
+            << std::right << std::setw (10) << ms
+            << std::setw (10) << std::fixed << std::setprecision (1)
+            << ms * 1e6 / operations
+            << std::setw (10) << std::setprecision (2)
+            << (ms > 0 ? double (reference) / ms : 0.0)
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t operations = 10000000;
+  std::string resolution = "NS";
+
+  CommandLine cmd;
+  cmd.AddValue ("operations", "Number of operations of each kind", operations);
+  cmd.AddValue ("resolution", "Time resolution: NS or PS", resolution);
+  cmd.Parse (argc, argv);
+
+  if (resolution == "PS")
+    {
+      Time::SetResolution (Time::PS);
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  std::vector<double> seconds (VALUES);
+  std::vector<uint64_t> milliSeconds (VALUES);
+  std::vector<Time> times (VALUES);
+  for (uint32_t i = 0; i < VALUES; i++)
+    {
+      seconds[i] = random->GetValue (0, 1000);
+      milliSeconds[i] = random->GetInteger (0, 1000000);
+      times[i] = Seconds (seconds[i]);
+    }
+
+  std::cout << std::left << std::setw (34) << "operation"
+            << std::right << std::setw (10) << "ms"
+            << std::setw (10) << "ns/op"
+            << std::setw (10) << "speedup"
+            << std::endl;
+
+  SystemWallClockMs clock;
+  int64_t sum = 0;
+  double total = 0;
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += Time::From (int64x64_t (seconds[i % VALUES]), Time::S).GetTimeStep ();
+    }
+  int64_t reference = clock.End ();
+  Report ("From (int64x64_t (s), Time::S)", reference, operations, reference);
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += Seconds (seconds[i % VALUES]).GetTimeStep ();
+    }
+  Report ("Seconds (s)", clock.End (), operations, reference);
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += Time::From (int64x64_t (milliSeconds[i % VALUES]), Time::MS).GetTimeStep ();
+    }
+  reference = clock.End ();
+  Report ("From (int64x64_t (ms), Time::MS)", reference, operations, reference);
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += MilliSeconds (milliSeconds[i % VALUES]).GetTimeStep ();
+    }
+  Report ("MilliSeconds (ms)", clock.End (), operations, reference);
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      total += times[i % VALUES].To (Time::S).GetDouble ();
+    }
+  reference = clock.End ();
+  Report ("To (Time::S).GetDouble ()", reference, operations, reference);
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      total += times[i % VALUES].GetSeconds ();
+    }
+  Report ("GetSeconds ()", clock.End (), operations, reference);
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += times[i % VALUES].To (Time::MS).GetHigh ();
+    }
+  reference = clock.End ();
+  Report ("To (Time::MS).GetHigh ()", reference, operations, reference);
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      sum += times[i % VALUES].GetMilliSeconds ();
+    }
+  Report ("GetMilliSeconds ()", clock.End (), operations, reference);
+
+  // keep the results alive
+  std::cout << "checksum " << sum << " " << total << std::endl;
+  return 0;
+}
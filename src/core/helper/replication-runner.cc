@@ -0,0 +1,245 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "replication-runner.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/fatal-error.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ReplicationRunner");
+
+ReplicationRunner::ReplicationRunner ()
+  : m_firstRun (1),
+    m_runs (1),
+    m_maxProcesses (0),
+    m_worker (false),
+    m_run (0),
+    m_failures (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ReplicationRunner::SetRuns (uint64_t first, uint32_t count)
+{
+  NS_LOG_FUNCTION (this << first << count);
+  m_firstRun = first;
+  m_runs = count;
+}
+
+void
+ReplicationRunner::SetMaxProcesses (uint32_t count)
+{
+  NS_LOG_FUNCTION (this << count);
+  m_maxProcesses = count;
+}
+
+void
+ReplicationRunner::AddOutput (std::string filename, enum MergeMode mode)
+{
+  NS_LOG_FUNCTION (this << filename << mode);
+  Output output;
+  output.filename = filename;
+  output.mode = mode;
+  m_outputs.push_back (output);
+}
+
+uint64_t
+ReplicationRunner::GetRun (void) const
+{
+  return m_run;
+}
+
+uint32_t
+ReplicationRunner::GetFailures (void) const
+{
+  return m_failures;
+}
+
+std::string
+ReplicationRunner::GetWorkerFilename (std::string filename, uint64_t run)
+{
+  std::ostringstream oss;
+  oss << filename << ".run" << run;
+  return oss.str ();
+}
+
+std::string
+ReplicationRunner::GetOutputFilename (std::string filename) const
+{
+  NS_ABORT_MSG_IF (!m_worker, "ReplicationRunner::GetOutputFilename(): not in a worker");
+  return GetWorkerFilename (filename, m_run);
+}
+
+bool
+ReplicationRunner::Fork (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_worker, "ReplicationRunner::Fork(): already in a worker");
+  uint32_t maxProcesses = m_maxProcesses;
+  if (maxProcesses == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      maxProcesses = processors > 0 ? processors : 1;
+    }
+
+  std::map<pid_t, uint32_t> running;
+  std::vector<bool> failed (m_runs, false);
+  uint32_t next = 0;
+  while (next < m_runs || !running.empty ())
+    {
+      if (next < m_runs && running.size () < maxProcesses)
+        {
+          // do not write the buffered output once more in the worker
+          std::cout.flush ();
+          std::cerr.flush ();
+          std::fflush (0);
+          pid_t pid = fork ();
+          if (pid < 0)
+            {
+              NS_FATAL_ERROR ("ReplicationRunner::Fork(): fork() failed: " << std::strerror (errno));
+            }
+          if (pid == 0)
+            {
+              m_worker = true;
+              m_run = m_firstRun + next;
+              RngSeedManager::SetRun (m_run);
+              RandomVariableStream::ReseedAll ();
+              return true;
+            }
+          NS_LOG_LOGIC ("run " << m_firstRun + next << " in process " << pid);
+          running[pid] = next;
+          next++;
+          continue;
+        }
+      int status;
+      pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("ReplicationRunner::Fork(): waitpid() failed: " << std::strerror (errno));
+        }
+      std::map<pid_t, uint32_t>::iterator i = running.find (pid);
+      if (i == running.end ())
+        {
+          continue;
+        }
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        {
+          NS_LOG_WARN ("run " << m_firstRun + i->second << " failed");
+          failed[i->second] = true;
+        }
+      running.erase (i);
+    }
+
+  for (std::vector<Output>::const_iterator i = m_outputs.begin (); i != m_outputs.end (); ++i)
+    {
+      Merge (*i, failed);
+    }
+  m_failures = 0;
+  for (uint32_t i = 0; i < m_runs; i++)
+    {
+      m_failures += failed[i];
+    }
+  return false;
+}
+
+void
+ReplicationRunner::Merge (const Output &output, std::vector<bool> &failed) const
+{
+  NS_LOG_FUNCTION (this << output.filename);
+  std::ofstream os (output.filename.c_str ());
+  NS_ABORT_MSG_IF (!os.is_open (), "ReplicationRunner: could not open " << output.filename);
+  if (output.mode == XML)
+    {
+      os << "<?xml version=\"1.0\" ?>" << std::endl
+         << "<Replications>" << std::endl;
+    }
+  for (uint32_t i = 0; i < m_runs; i++)
+    {
+      uint64_t run = m_firstRun + i;
+      std::string filename = GetWorkerFilename (output.filename, run);
+      std::ifstream is (filename.c_str ());
+      if (!is.is_open ())
+        {
+          NS_LOG_WARN ("run " << run << " did not write " << filename);
+          failed[i] = true;
+          continue;
+        }
+      std::ostringstream content;
+      content << is.rdbuf ();
+      is.close ();
+      std::remove (filename.c_str ());
+      if (output.mode == XML)
+        {
+          std::string document = content.str ();
+          // drop the XML declaration of the document
+          if (document.compare (0, 5, "<?xml") == 0)
+            {
+              std::string::size_type end = document.find ("?>");
+              document = end == std::string::npos ? "" : document.substr (end + 2);
+              document.erase (0, document.find_first_not_of ("\r\n"));
+            }
+          os << "<Replication run=\"" << run << "\">" << std::endl
+             << document;
+          if (!document.empty () && document[document.size () - 1] != '\n')
+            {
+              os << std::endl;
+            }
+          os << "</Replication>" << std::endl;
+        }
+      else
+        {
+          os << content.str ();
+        }
+    }
+  if (output.mode == XML)
+    {
+      os << "</Replications>" << std::endl;
+    }
+}
+
+void
+ReplicationRunner::Exit (int status)
+{
+  NS_LOG_FUNCTION (this << status);
+  NS_ABORT_MSG_IF (!m_worker, "ReplicationRunner::Exit(): not in a worker");
+  // the static objects belong to the parent: flush the output, but do
+  // not run their destructors.
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::fflush (0);
+  _exit (status);
+}
+
+} // namespace ns3
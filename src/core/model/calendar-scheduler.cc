@@ -252,6 +252,38 @@ CalendarScheduler::Remove (const Event &ev)
   NS_ASSERT (false);
 }
 
+void
+CalendarScheduler::RemoveCancelled (std::vector<Scheduler::Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t bucket = 0; bucket < m_nBuckets; bucket++)
+    {
+      Bucket::iterator i = m_buckets[bucket].begin ();
+      while (i != m_buckets[bucket].end ())
+        {
+          if (i->impl->IsCancelled ())
+            {
+              cancelled.push_back (*i);
+              i = m_buckets[bucket].erase (i);
+              m_qSize--;
+            }
+          else
+            {
+              ++i;
+            }
+        }
+    }
+  uint32_t newSize = m_nBuckets;
+  while (m_qSize < newSize / 2)
+    {
+      newSize /= 2;
+    }
+  if (newSize != m_nBuckets)
+    {
+      Resize (newSize);
+    }
+}
+
 void
 CalendarScheduler::ResizeUp (void)
 {
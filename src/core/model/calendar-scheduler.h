@@ -24,6 +24,7 @@
 #include "scheduler.h"
 #include <stdint.h>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -69,6 +70,7 @@ public:
 
   // Inherited
   virtual void Insert (const Scheduler::Event &ev);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &cancelled);
   virtual bool IsEmpty (void) const;
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
@@ -0,0 +1,287 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "checkpoint.h"
+#include "fatal-error.h"
+#include "abort.h"
+#include "log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Checkpoint");
+
+namespace {
+
+/**
+ * Read a buffer from a pipe.
+ *
+ * \param [in] fd The pipe.
+ * \param [out] buffer The buffer.
+ * \param [in] size The size of the buffer.
+ * \returns \c false at the end of the file or on error.
+ */
+bool
+ReadAll (int fd, void *buffer, std::size_t size)
+{
+  char *p = static_cast<char *> (buffer);
+  while (size > 0)
+    {
+      ssize_t n = read (fd, p, size);
+      if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (n <= 0)
+        {
+          return false;
+        }
+      p += n;
+      size -= n;
+    }
+  return true;
+}
+
+/**
+ * Write a buffer to a pipe.
+ *
+ * \param [in] fd The pipe.
+ * \param [in] buffer The buffer.
+ * \param [in] size The size of the buffer.
+ * \returns \c false on error.
+ */
+bool
+WriteAll (int fd, const void *buffer, std::size_t size)
+{
+  const char *p = static_cast<const char *> (buffer);
+  while (size > 0)
+    {
+      ssize_t n = write (fd, p, size);
+      if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (n <= 0)
+        {
+          return false;
+        }
+      p += n;
+      size -= n;
+    }
+  return true;
+}
+
+/**
+ * Flush the buffered output, so that it is not written again by the
+ * child processes.
+ */
+void
+FlushAll (void)
+{
+  std::cout.flush ();
+  std::cerr.flush ();
+  std::clog.flush ();
+  std::fflush (0);
+}
+
+} // anonymous namespace
+
+Checkpoint::Checkpoint ()
+  : m_snapshot (-1),
+    m_commands (-1),
+    m_replies (-1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Checkpoint::~Checkpoint ()
+{
+  NS_LOG_FUNCTION (this);
+  Release ();
+}
+
+bool
+Checkpoint::IsTaken (void) const
+{
+  return m_snapshot != -1;
+}
+
+uint32_t
+Checkpoint::Take (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (IsTaken (), "Checkpoint::Take(): a snapshot is already held");
+  int commands[2];
+  int replies[2];
+  if (pipe (commands) != 0)
+    {
+      NS_FATAL_ERROR ("Checkpoint::Take(): pipe() failed: " << std::strerror (errno));
+    }
+  if (pipe (replies) != 0)
+    {
+      NS_FATAL_ERROR ("Checkpoint::Take(): pipe() failed: " << std::strerror (errno));
+    }
+  FlushAll ();
+  pid_t pid = fork ();
+  if (pid < 0)
+    {
+      NS_FATAL_ERROR ("Checkpoint::Take(): fork() failed: " << std::strerror (errno));
+    }
+  if (pid == 0)
+    {
+      close (commands[1]);
+      close (replies[0]);
+      m_commands = commands[0];
+      m_replies = replies[1];
+      return Serve ();
+    }
+  close (commands[0]);
+  close (replies[1]);
+  m_snapshot = pid;
+  m_commands = commands[1];
+  m_replies = replies[0];
+  NS_LOG_LOGIC ("snapshot held by process " << pid);
+  return ORIGINAL;
+}
+
+uint32_t
+Checkpoint::Serve (void)
+{
+  std::vector<pid_t> children;
+  Command command;
+  while (ReadAll (m_commands, &command, sizeof (command)))
+    {
+      if (command.type == Command::RESUME)
+        {
+          FlushAll ();
+          pid_t pid = fork ();
+          if (pid == 0)
+            {
+              // a new copy of the simulation, which goes on from the
+              // point where the snapshot was taken.
+              Close ();
+              return command.variant;
+            }
+          WriteAll (m_replies, &pid, sizeof (pid));
+          if (pid > 0)
+            {
+              children.push_back (pid);
+            }
+        }
+      else if (command.type == Command::WAIT)
+        {
+          uint32_t failures = 0;
+          for (std::vector<pid_t>::const_iterator i = children.begin (); i != children.end (); ++i)
+            {
+              int status;
+              while (waitpid (*i, &status, 0) < 0 && errno == EINTR)
+                {
+                }
+              if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+                {
+                  failures++;
+                }
+            }
+          children.clear ();
+          WriteAll (m_replies, &failures, sizeof (failures));
+        }
+    }
+  // the snapshot was released, or the original process exited: do
+  // not run the destructors of the copied objects.
+  _exit (0);
+}
+
+pid_t
+Checkpoint::Resume (uint32_t variant)
+{
+  NS_LOG_FUNCTION (this << variant);
+  NS_ABORT_MSG_IF (!IsTaken (), "Checkpoint::Resume(): no snapshot is held");
+  Command command;
+  std::memset (&command, 0, sizeof (command));
+  command.type = Command::RESUME;
+  command.variant = variant;
+  pid_t pid = -1;
+  if (!WriteAll (m_commands, &command, sizeof (command))
+      || !ReadAll (m_replies, &pid, sizeof (pid)))
+    {
+      NS_FATAL_ERROR ("Checkpoint::Resume(): the snapshot process died");
+    }
+  NS_LOG_LOGIC ("variant " << variant << " runs in process " << pid);
+  return pid;
+}
+
+uint32_t
+Checkpoint::Wait (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (!IsTaken (), "Checkpoint::Wait(): no snapshot is held");
+  Command command;
+  std::memset (&command, 0, sizeof (command));
+  command.type = Command::WAIT;
+  uint32_t failures = 0;
+  if (!WriteAll (m_commands, &command, sizeof (command))
+      || !ReadAll (m_replies, &failures, sizeof (failures)))
+    {
+      NS_FATAL_ERROR ("Checkpoint::Wait(): the snapshot process died");
+    }
+  return failures;
+}
+
+void
+Checkpoint::Release (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!IsTaken ())
+    {
+      return;
+    }
+  Close ();
+  int status;
+  while (waitpid (m_snapshot, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+  m_snapshot = -1;
+}
+
+void
+Checkpoint::Close (void)
+{
+  if (m_commands != -1)
+    {
+      close (m_commands);
+      m_commands = -1;
+    }
+  if (m_replies != -1)
+    {
+      close (m_replies);
+      m_replies = -1;
+    }
+}
+
+} // namespace ns3
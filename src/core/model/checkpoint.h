@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::Checkpoint declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief A snapshot of the whole simulation, which can be resumed
+ * any number of times.
+ *
+ * Take() forks a process which holds a frozen copy of the whole
+ * simulation: the pending events, the nodes and all the other
+ * objects with their attributes, and the positions of the random
+ * number streams.  The pending events are closures over arbitrary
+ * C++ objects, which cannot be serialized in general, so the
+ * snapshot lives in memory, in the copy-on-write pages of this
+ * process, rather than in a file.
+ *
+ * Resume() then asks the snapshot to fork a new process, which
+ * returns from Take() with the variant number given to Resume, and
+ * continues the simulation from the time of the snapshot.  The
+ * typical use is to share a long warm-up between the variants of a
+ * parameter sweep:
+ *
+ * \code
+ *   void
+ *   EndOfWarmUp (Checkpoint *checkpoint)
+ *   {
+ *     uint32_t variant = checkpoint->Take ();
+ *     if (variant == Checkpoint::ORIGINAL)
+ *       {
+ *         for (uint32_t i = 0; i < 10; i++)
+ *           {
+ *             checkpoint->Resume (i);
+ *           }
+ *         checkpoint->Wait ();
+ *         checkpoint->Release ();
+ *         Simulator::Stop ();
+ *         return;
+ *       }
+ *     // configure the parameters of this variant, then go on
+ *   }
+ * \endcode
+ *
+ * The simulation must run in a single thread: fork() copies only the
+ * calling thread, so Take must not be used with
+ * MultithreadedSimulatorImpl, nor while other threads are running.
+ */
+class Checkpoint
+{
+public:
+  /** Returned by Take in the process which took the snapshot. */
+  static const uint32_t ORIGINAL = 0xffffffff;
+
+  Checkpoint ();
+  /** Release the snapshot, if any. */
+  ~Checkpoint ();
+
+  /**
+   * Take a snapshot of the simulation, usually from within an event.
+   *
+   * \returns ORIGINAL in the calling process, and the variant number
+   * in the processes started by Resume.
+   */
+  uint32_t Take (void);
+  /**
+   * Start a new process from the snapshot.  The process runs
+   * concurrently with this one.
+   *
+   * \param [in] variant The value returned by Take in the new process.
+   * \returns The process id of the new process, or -1 on error.
+   */
+  pid_t Resume (uint32_t variant);
+  /**
+   * Wait for all the processes started by Resume to exit.
+   *
+   * \returns The number of processes which failed, that is, which did
+   * not exit with a zero status.
+   */
+  uint32_t Wait (void);
+  /**
+   * Discard the snapshot.  The processes started by Resume are not
+   * affected.
+   */
+  void Release (void);
+  /**
+   * \returns \c true if a snapshot is held.
+   */
+  bool IsTaken (void) const;
+
+private:
+  /** A request to the snapshot process. */
+  struct Command
+  {
+    /** The kind of request. */
+    enum Type
+    {
+      RESUME,  //!< Start a new process
+      WAIT     //!< Wait for the started processes
+    } type;    //!< The kind of request
+    uint32_t variant;  //!< The variant of RESUME
+  };
+
+  /**
+   * Serve the requests to the snapshot.  Does not return in the
+   * snapshot process; returns the variant number in the resumed ones.
+   *
+   * \returns The variant number.
+   */
+  uint32_t Serve (void);
+  /** Close the pipes to the snapshot process. */
+  void Close (void);
+
+  pid_t m_snapshot;      //!< The snapshot process, or -1
+  int m_commands;        //!< Pipe of the requests to the snapshot
+  int m_replies;         //!< Pipe of the replies of the snapshot
+};
+
+} // namespace ns3
+
+#endif /* CHECKPOINT_H */
@@ -795,21 +795,20 @@ bool SetDefaultFailSafe (std::string fullName, const AttributeValue &value)
     {
       return false;
     }
-  for (uint32_t j = 0; j < tid.GetAttributeN (); j++)
+  // only the attributes of the type itself, not those of its parents
+  Ptr<const TypeId::AttributeTable> table = tid.GetAttributeTable ();
+  uint32_t i = table->Find (paramName);
+  if (i == TypeId::AttributeTable::NOT_FOUND || table->attributes[i].uid != tid.GetUid ())
     {
-      struct TypeId::AttributeInformation tmp = tid.GetAttribute(j);
-      if (tmp.name == paramName)
-        {
-          Ptr<AttributeValue> v = tmp.checker->CreateValidValue (value);
-          if (v == 0)
-            {
-              return false;
-            }
-          tid.SetAttributeInitialValue (j, v);
-          return true;
-        }
+      return false;
     }
-  return false;
+  Ptr<AttributeValue> v = table->attributes[i].info.checker->CreateValidValue (value);
+  if (v == 0)
+    {
+      return false;
+    }
+  tid.SetAttributeInitialValue (table->attributes[i].index, v);
+  return true;
 }
 void SetGlobal (std::string name, const AttributeValue &value)
 {
@@ -22,13 +22,21 @@
 #include "default-simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-batch.h"
 
 #include "ptr.h"
 #include "pointer.h"
+#include "string.h"
+#include "enum.h"
+#include "double.h"
+#include "uinteger.h"
 #include "assert.h"
+#include "abort.h"
 #include "log.h"
 
 #include <cmath>
+#include <fstream>
+#include <vector>
 
 
 /**
@@ -53,6 +61,30 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("ProfileFile",
+                   "The file of the event profile report, written at the end of "
+                   "each run; empty to disable the event profiler.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::m_profileFile),
+                   MakeStringChecker ())
+    .AddAttribute ("ProfileFormat",
+                   "The format of the event profile report.",
+                   EnumValue (EventProfiler::CSV),
+                   MakeEnumAccessor (&DefaultSimulatorImpl::m_profileFormat),
+                   MakeEnumChecker (EventProfiler::CSV, "Csv",
+                                    EventProfiler::COLLAPSED, "Collapsed"))
+    .AddAttribute ("CompactionThreshold",
+                   "The fraction of cancelled events among the pending events "
+                   "above which the cancelled events are removed from the "
+                   "scheduler; zero disables the compaction.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&DefaultSimulatorImpl::m_compactionThreshold),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("CompactionMinimum",
+                   "The minimum number of cancelled events for a compaction.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_compactionMinimum),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -71,13 +103,16 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_pendingCancelled = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
+  m_profiler = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
+  delete m_profiler;
 }
 
 void
@@ -146,7 +181,20 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (next.impl->IsCancelled () && m_pendingCancelled > 0)
+    {
+      m_pendingCancelled--;
+    }
+  if (m_profiler == 0)
+    {
+      next.impl->Invoke ();
+    }
+  else
+    {
+      m_profiler->Start ();
+      next.impl->Invoke ();
+      m_profiler->Stop (next.key.m_context, next.impl);
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -196,6 +244,10 @@ DefaultSimulatorImpl::Run (void)
   m_main = SystemThread::Self();
   ProcessEventsWithContext ();
   m_stop = false;
+  if (m_profiler == 0 && !m_profileFile.empty ())
+    {
+      m_profiler = new EventProfiler ();
+    }
 
   while (!m_events->IsEmpty () && !m_stop) 
     {
@@ -205,6 +257,13 @@ DefaultSimulatorImpl::Run (void)
   // If the simulator stopped naturally by lack of events, make a
   // consistency test to check that we didn't lose any events along the way.
   NS_ASSERT (!m_events->IsEmpty () || m_unscheduledEvents == 0);
+
+  if (m_profiler != 0)
+    {
+      std::ofstream os (m_profileFile.c_str ());
+      NS_ABORT_MSG_IF (!os.is_open (), "Could not open the event profile report " << m_profileFile);
+      m_profiler->Write (os, m_profileFormat);
+    }
 }
 
 void 
@@ -277,6 +336,46 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
 }
 
+void
+DefaultSimulatorImpl::ScheduleBatch (const EventBatch &batch)
+{
+  NS_LOG_FUNCTION (this << batch.GetN ());
+
+  if (SystemThread::Equals (m_main))
+    {
+      // the uids follow the order of the batch, as with one
+      // ScheduleWithContext() per event
+      std::vector<Scheduler::Event> events (batch.GetN ());
+      for (uint32_t i = 0; i < batch.GetN (); i++)
+        {
+          const EventBatch::Entry &entry = batch.Get (i);
+          Time tAbsolute = entry.delay + TimeStep (m_currentTs);
+          events[i].impl = entry.event;
+          events[i].key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+          events[i].key.m_context = entry.context;
+          events[i].key.m_uid = m_uid;
+          m_uid++;
+        }
+      m_unscheduledEvents += batch.GetN ();
+      m_events->InsertBatch (events);
+    }
+  else
+    {
+      CriticalSection cs (m_eventsWithContextMutex);
+      for (uint32_t i = 0; i < batch.GetN (); i++)
+        {
+          const EventBatch::Entry &entry = batch.Get (i);
+          EventWithContext ev;
+          ev.context = entry.context;
+          // Current time added in ProcessEventsWithContext()
+          ev.timestamp = entry.delay.GetTimeStep ();
+          ev.event = entry.event;
+          m_eventsWithContext.push_back (ev);
+        }
+      m_eventsWithContextEmpty = false;
+    }
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
@@ -363,9 +462,67 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      if (id.GetUid () == 2)
+        {
+          // destroy events are not in the scheduler
+          return;
+        }
+      m_cancelStats.cancelled++;
+      m_pendingCancelled++;
+      if (m_compactionThreshold > 0
+          && m_pendingCancelled >= m_compactionMinimum
+          && m_pendingCancelled > m_compactionThreshold * m_unscheduledEvents)
+        {
+          Compact ();
+        }
     }
 }
 
+void
+DefaultSimulatorImpl::Compact (void)
+{
+  NS_LOG_FUNCTION (this << m_pendingCancelled << m_unscheduledEvents);
+  std::vector<Scheduler::Event> cancelled;
+  m_events->RemoveCancelled (cancelled);
+  for (std::vector<Scheduler::Event>::const_iterator i = cancelled.begin (); i != cancelled.end (); ++i)
+    {
+      i->impl->Unref ();
+    }
+  m_unscheduledEvents -= cancelled.size ();
+  m_pendingCancelled = 0;
+  m_cancelStats.compactions++;
+  m_cancelStats.compacted += cancelled.size ();
+}
+
+DefaultSimulatorImpl::CancelStats::CancelStats ()
+  : pending (0),
+    pendingCancelled (0),
+    cancelled (0),
+    compactions (0),
+    compacted (0)
+{
+}
+
+DefaultSimulatorImpl::CancelStats
+DefaultSimulatorImpl::GetCancelStats (void) const
+{
+  CancelStats stats = m_cancelStats;
+  stats.pending = m_unscheduledEvents;
+  stats.pendingCancelled = m_pendingCancelled;
+  return stats;
+}
+
+std::ostream &
+operator << (std::ostream &os, const DefaultSimulatorImpl::CancelStats &stats)
+{
+  os << "pending=" << stats.pending
+     << " pendingCancelled=" << stats.pendingCancelled
+     << " cancelled=" << stats.cancelled
+     << " compactions=" << stats.compactions
+     << " compacted=" << stats.compacted;
+  return os;
+}
+
 bool
 DefaultSimulatorImpl::IsExpired (const EventId &id) const
 {
@@ -27,9 +27,12 @@
 #include "system-thread.h"
 #include "ns3/system-mutex.h"
 
+#include "event-profiler.h"
 #include "ptr.h"
 
 #include <list>
+#include <ostream>
+#include <string>
 
 /**
  * \file
@@ -43,6 +46,17 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * Setting the ProfileFile attribute enables the event profiler: the
+ * wall-clock time spent in each event is then accumulated by module,
+ * by node and by callback, and a report is written to the file at the
+ * end of each call to Run, in the format selected by the
+ * ProfileFormat attribute.  See EventProfiler.
+ *
+ * \code
+ *   Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFile",
+ *                       StringValue ("profile.csv"));
+ * \endcode
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -65,6 +79,7 @@ public:
   virtual void Stop (Time const &delay);
   virtual EventId Schedule (Time const &delay, EventImpl *event);
   virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual void ScheduleBatch (const EventBatch &batch);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
   virtual void Remove (const EventId &id);
@@ -78,11 +93,37 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /** Statistics of the cancelled events. */
+  struct CancelStats
+  {
+    /** Constructor: all counters are zero. */
+    CancelStats ();
+    /** Number of events in the scheduler, cancelled or not. */
+    uint32_t pending;
+    /** Number of cancelled events still in the scheduler. */
+    uint32_t pendingCancelled;
+    /** Number of events cancelled with Cancel(). */
+    uint64_t cancelled;
+    /** Number of compactions of the scheduler. */
+    uint64_t compactions;
+    /** Number of cancelled events removed by the compactions. */
+    uint64_t compacted;
+  };
+
+  /**
+   * Get the statistics of the cancelled events.
+   *
+   * \returns The statistics.
+   */
+  CancelStats GetCancelStats (void) const;
+
 private:
   virtual void DoDispose (void);
 
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /** Remove the cancelled events from the scheduler. */
+  void Compact (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
  
@@ -130,10 +171,42 @@ private:
    */
   int m_unscheduledEvents;
 
+  /**
+   * Number of cancelled events still in the scheduler.  Events
+   * cancelled directly with EventImpl::Cancel are not counted until the
+   * next compaction.
+   */
+  uint32_t m_pendingCancelled;
+  /** The statistics of the cancelled events. */
+  CancelStats m_cancelStats;
+  /**
+   * Fraction of cancelled events among the pending events above which
+   * the scheduler is compacted; zero disables the compaction.
+   */
+  double m_compactionThreshold;
+  /** Minimum number of cancelled events for a compaction. */
+  uint32_t m_compactionMinimum;
+
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** The event profiler, if enabled. */
+  EventProfiler *m_profiler;
+  /** The file of the profile report; empty to disable profiling. */
+  std::string m_profileFile;
+  /** The format of the profile report. */
+  enum EventProfiler::Format m_profileFormat;
 };
 
+/**
+ * Output streamer for DefaultSimulatorImpl::CancelStats.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] stats The statistics.
+ * \returns The stream.
+ */
+std::ostream & operator << (std::ostream &os, const DefaultSimulatorImpl::CancelStats &stats);
+
 } // namespace ns3
 
 #endif /* DEFAULT_SIMULATOR_IMPL_H */
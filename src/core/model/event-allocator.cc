@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-config.h"
+#include "event-allocator.h"
+#include "log.h"
+#include <new>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventAllocator definitions.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventAllocator");
+
+namespace {
+
+/** Size classes are multiples of this size, which is also the alignment. */
+const std::size_t GRANULARITY = 16;
+/** Number of size classes. */
+const uint32_t SIZE_CLASSES = 16;
+/** Size of the chunks obtained from the system. */
+const std::size_t CHUNK_SIZE = 64 * 1024;
+
+/** A free block, linked in the free list of its size class. */
+struct Block
+{
+  Block *next;  //!< Next free block
+};
+
+/** The header of a chunk, which keeps the chunks reachable. */
+struct Chunk
+{
+  Chunk *next;  //!< Previously allocated chunk
+};
+
+/** The free lists and the statistics of a thread. */
+struct Pool
+{
+  /** Constructor. */
+  Pool ()
+    : next (0)
+  {
+    for (uint32_t i = 0; i < SIZE_CLASSES; i++)
+      {
+        free[i] = 0;
+      }
+  }
+  Block *free[SIZE_CLASSES];    //!< Free lists, by size class
+  EventAllocator::Stats stats;  //!< Statistics of this thread
+  Pool *next;                   //!< Next pool in g_pools
+};
+
+/** All the chunks obtained from the system. */
+Chunk *g_chunks = 0;
+
+#ifdef HAVE_PTHREAD_H
+/** Protects the shared state below. */
+pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Creates g_key once. */
+pthread_once_t g_once = PTHREAD_ONCE_INIT;
+/** The pool of the current thread. */
+pthread_key_t g_key;
+/** The pools of the running threads. */
+Pool *g_pools = 0;
+/** Free blocks handed over by the threads which exited. */
+Block *g_shared[SIZE_CLASSES];
+/** Statistics of the threads which exited. */
+EventAllocator::Stats g_retired;
+
+/** Lock the shared state. */
+void
+Lock (void)
+{
+  pthread_mutex_lock (&g_mutex);
+}
+/** Unlock the shared state. */
+void
+Unlock (void)
+{
+  pthread_mutex_unlock (&g_mutex);
+}
+
+/**
+ * Hand the free blocks and statistics of an exiting thread over
+ * to the shared state.
+ *
+ * \param [in] data The Pool of the thread.
+ */
+void
+ReleasePool (void *data)
+{
+  Pool *pool = static_cast<Pool *> (data);
+  Lock ();
+  for (uint32_t i = 0; i < SIZE_CLASSES; i++)
+    {
+      Block *block = pool->free[i];
+      if (block == 0)
+        {
+          continue;
+        }
+      while (block->next != 0)
+        {
+          block = block->next;
+        }
+      block->next = g_shared[i];
+      g_shared[i] = pool->free[i];
+    }
+  g_retired.allocations += pool->stats.allocations;
+  g_retired.deallocations += pool->stats.deallocations;
+  g_retired.recycled += pool->stats.recycled;
+  g_retired.oversized += pool->stats.oversized;
+  g_retired.chunks += pool->stats.chunks;
+  g_retired.reservedBytes += pool->stats.reservedBytes;
+  for (Pool **i = &g_pools; *i != 0; i = &(*i)->next)
+    {
+      if (*i == pool)
+        {
+          *i = pool->next;
+          break;
+        }
+    }
+  Unlock ();
+  delete pool;
+}
+
+/** Create g_key. */
+void
+CreateKey (void)
+{
+  pthread_key_create (&g_key, &ReleasePool);
+}
+
+/** \returns The pool of the current thread. */
+Pool *
+GetPool (void)
+{
+  pthread_once (&g_once, &CreateKey);
+  Pool *pool = static_cast<Pool *> (pthread_getspecific (g_key));
+  if (pool == 0)
+    {
+      pool = new Pool ();
+      Lock ();
+      pool->next = g_pools;
+      g_pools = pool;
+      Unlock ();
+      pthread_setspecific (g_key, pool);
+    }
+  return pool;
+}
+#else /* HAVE_PTHREAD_H */
+/** Lock the shared state. */
+void
+Lock (void)
+{
+}
+/** Unlock the shared state. */
+void
+Unlock (void)
+{
+}
+/** \returns The only pool. */
+Pool *
+GetPool (void)
+{
+  static Pool pool;
+  return &pool;
+}
+#endif /* HAVE_PTHREAD_H */
+
+/**
+ * Refill an empty free list, with the blocks handed over by the
+ * threads which exited, or with a new chunk.
+ *
+ * \param [in,out] pool The pool of the current thread.
+ * \param [in] sizeClass The size class of the free list.
+ */
+void
+Refill (Pool *pool, uint32_t sizeClass)
+{
+  Lock ();
+#ifdef HAVE_PTHREAD_H
+  if (g_shared[sizeClass] != 0)
+    {
+      pool->free[sizeClass] = g_shared[sizeClass];
+      g_shared[sizeClass] = 0;
+      Unlock ();
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  char *buffer = static_cast<char *> (::operator new (CHUNK_SIZE));
+  Chunk *chunk = reinterpret_cast<Chunk *> (buffer);
+  chunk->next = g_chunks;
+  g_chunks = chunk;
+  Unlock ();
+  NS_LOG_LOGIC ("new chunk " << static_cast<void *> (buffer) << " for size class " << sizeClass);
+  pool->stats.chunks++;
+  pool->stats.reservedBytes += CHUNK_SIZE;
+
+  std::size_t blockSize = (sizeClass + 1) * GRANULARITY;
+  // the first GRANULARITY bytes hold the chunk header
+  Block *head = 0;
+  for (std::size_t i = (CHUNK_SIZE - GRANULARITY) / blockSize; i > 0; i--)
+    {
+      Block *block = reinterpret_cast<Block *> (buffer + GRANULARITY + (i - 1) * blockSize);
+      block->next = head;
+      head = block;
+    }
+  pool->free[sizeClass] = head;
+}
+
+} // anonymous namespace
+
+EventAllocator::Stats::Stats ()
+  : allocations (0),
+    deallocations (0),
+    recycled (0),
+    oversized (0),
+    chunks (0),
+    reservedBytes (0)
+{
+}
+
+void *
+EventAllocator::Allocate (std::size_t size)
+{
+  Pool *pool = GetPool ();
+  pool->stats.allocations++;
+  if (size > SIZE_CLASSES * GRANULARITY)
+    {
+      pool->stats.oversized++;
+      return ::operator new (size);
+    }
+  uint32_t sizeClass = (size - 1) / GRANULARITY;
+  Block *block = pool->free[sizeClass];
+  if (block == 0)
+    {
+      Refill (pool, sizeClass);
+      block = pool->free[sizeClass];
+    }
+  else
+    {
+      pool->stats.recycled++;
+    }
+  pool->free[sizeClass] = block->next;
+  return block;
+}
+
+void
+EventAllocator::Deallocate (void *buffer, std::size_t size)
+{
+  if (buffer == 0)
+    {
+      return;
+    }
+  Pool *pool = GetPool ();
+  pool->stats.deallocations++;
+  if (size > SIZE_CLASSES * GRANULARITY)
+    {
+      ::operator delete (buffer);
+      return;
+    }
+  uint32_t sizeClass = (size - 1) / GRANULARITY;
+  Block *block = static_cast<Block *> (buffer);
+  block->next = pool->free[sizeClass];
+  pool->free[sizeClass] = block;
+}
+
+EventAllocator::Stats
+EventAllocator::GetStats (void)
+{
+#ifdef HAVE_PTHREAD_H
+  Lock ();
+  Stats stats = g_retired;
+  for (Pool *pool = g_pools; pool != 0; pool = pool->next)
+    {
+      stats.allocations += pool->stats.allocations;
+      stats.deallocations += pool->stats.deallocations;
+      stats.recycled += pool->stats.recycled;
+      stats.oversized += pool->stats.oversized;
+      stats.chunks += pool->stats.chunks;
+      stats.reservedBytes += pool->stats.reservedBytes;
+    }
+  Unlock ();
+  return stats;
+#else /* HAVE_PTHREAD_H */
+  return GetPool ()->stats;
+#endif /* HAVE_PTHREAD_H */
+}
+
+std::ostream &
+operator << (std::ostream &os, const EventAllocator::Stats &stats)
+{
+  os << "allocations=" << stats.allocations
+     << " deallocations=" << stats.deallocations
+     << " recycled=" << stats.recycled
+     << " oversized=" << stats.oversized
+     << " chunks=" << stats.chunks
+     << " reservedBytes=" << stats.reservedBytes;
+  return os;
+}
+
+} // namespace ns3
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_ALLOCATOR_H
+#define EVENT_ALLOCATOR_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventAllocator declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup events
+ * \brief The memory allocator of the EventImpl instances.
+ *
+ * EventImpl overloads its operator new and operator delete to use
+ * this allocator, so that the events created by MakeEvent and by the
+ * Simulator::Schedule methods are allocated transparently from it.
+ *
+ * Requests are rounded up to a multiple of 16 bytes and served from
+ * one free list per size class; memory is obtained from the system in
+ * large chunks which are carved into blocks of a single size class.
+ * Requests larger than the biggest size class are forwarded to the
+ * global operator new.  Released blocks go back to the free list of
+ * their size class and are never returned to the system.
+ *
+ * When threads are supported, each thread owns its free lists, so
+ * that the common Allocate and Deallocate paths take no lock.  A block
+ * released by another thread than the one which allocated it joins the
+ * free lists of the releasing thread.  The free lists of a thread are
+ * handed over to the other threads when it exits.
+ */
+class EventAllocator
+{
+public:
+  /** Allocation statistics. */
+  struct Stats
+  {
+    /** Constructor: all counters are zero. */
+    Stats ();
+    /** Number of calls to Allocate. */
+    uint64_t allocations;
+    /** Number of calls to Deallocate. */
+    uint64_t deallocations;
+    /** Number of allocations served by a recycled block. */
+    uint64_t recycled;
+    /** Number of allocations forwarded to the global operator new. */
+    uint64_t oversized;
+    /** Number of chunks obtained from the system. */
+    uint64_t chunks;
+    /** Total size of the chunks, in bytes. */
+    uint64_t reservedBytes;
+  };
+
+  /**
+   * Allocate a block.
+   *
+   * \param [in] size The size of the block, in bytes.
+   * \returns The block.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Release a block.
+   *
+   * \param [in] buffer The block, as returned by Allocate.
+   * \param [in] size The size passed to Allocate.
+   */
+  static void Deallocate (void *buffer, std::size_t size);
+  /**
+   * Get the allocation statistics, summed over all threads since the
+   * start of the program.
+   *
+   * The counters of the threads which are running are read without
+   * synchronization, so they may be slightly out of date.
+   *
+   * \returns The statistics.
+   */
+  static Stats GetStats (void);
+};
+
+/**
+ * Output streamer for EventAllocator::Stats.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] stats The statistics.
+ * \returns The stream.
+ */
+std::ostream & operator << (std::ostream &os, const EventAllocator::Stats &stats);
+
+} // namespace ns3
+
+#endif /* EVENT_ALLOCATOR_H */
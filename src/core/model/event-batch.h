@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_BATCH_H
+#define EVENT_BATCH_H
+
+#include <stdint.h>
+#include <vector>
+#include "nstime.h"
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::EventBatch declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup events
+ * \brief A set of events to be scheduled at once.
+ *
+ * Channels deliver one packet to many receivers, each with its own
+ * propagation delay and context. Instead of calling
+ * Simulator::ScheduleWithContext() once per receiver, they can collect
+ * the events in an EventBatch and hand the whole set over to
+ * Simulator::ScheduleBatch(), which lets the simulator and its scheduler
+ * insert them in a single pass.
+ *
+ * The events are scheduled in the order they were added, exactly as
+ * if ScheduleWithContext() had been called for each of them in turn:
+ * events with equal timestamps run in that order.
+ *
+ * \code
+ *   EventBatch batch;
+ *   for (...)
+ *     {
+ *       batch.Add (dstNode, delay, MakeEvent (&Phy::StartRx, phy, copy));
+ *     }
+ *   Simulator::ScheduleBatch (batch);
+ * \endcode
+ *
+ * The batch owns its events until it is scheduled: the events of a
+ * batch which is destroyed or cleared before are released.
+ */
+class EventBatch
+{
+public:
+  /** An event of the batch. */
+  struct Entry
+  {
+    uint32_t context;   /**< The context of the event. */
+    Time delay;         /**< The delay until the event expires. */
+    EventImpl *event;   /**< The event. */
+  };
+
+  /** Constructor. */
+  EventBatch ();
+  /** Destructor. Releases the events not yet scheduled. */
+  ~EventBatch ();
+
+  /**
+   * Add an event to the batch.
+   *
+   * \param [in] context The context of the event.
+   * \param [in] delay The delay until the event expires.
+   * \param [in] event The event, usually created by MakeEvent().
+   *        The batch takes ownership of the event.
+   */
+  void Add (uint32_t context, Time const &delay, EventImpl *event);
+  /**
+   * \returns The number of events in the batch.
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \param [in] i The index of the event.
+   * \returns The event.
+   */
+  const Entry & Get (uint32_t i) const;
+  /**
+   * \returns \c true if the batch holds no event.
+   */
+  bool IsEmpty (void) const;
+  /**
+   * Release all the events of the batch without scheduling them.
+   */
+  void Clear (void);
+
+private:
+  friend class Simulator;
+
+  /**
+   * Empty the batch once the simulator took ownership of its events.
+   */
+  void Forget (void);
+
+  /**
+   * Copy constructor.
+   * Defined and unimplemented to avoid misuse.
+   */
+  EventBatch (const EventBatch &);
+  /**
+   * Copy assignment.
+   * Defined and unimplemented to avoid misuse.
+   * \returns The batch.
+   */
+  EventBatch & operator = (const EventBatch &);
+
+  /** The events. */
+  std::vector<Entry> m_entries;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_BATCH_H */
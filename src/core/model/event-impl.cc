@@ -19,6 +19,7 @@
  */
 
 #include "event-impl.h"
+#include "event-allocator.h"
 #include "log.h"
 
 /**
@@ -66,4 +67,16 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void *
+EventImpl::operator new (std::size_t size)
+{
+  return EventAllocator::Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *buffer, std::size_t size)
+{
+  EventAllocator::Deallocate (buffer, size);
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -40,6 +41,9 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The events are allocated by the EventAllocator, which recycles
+ * their memory.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +70,21 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate the memory of an event from the EventAllocator.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event to the EventAllocator.
+   *
+   * \param [in] buffer The memory.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *buffer, std::size_t size);
+
 protected:
   /**
    * Implementation for Invoke().
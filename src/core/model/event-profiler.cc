@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-config.h"
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "type-id.h"
+#include "log.h"
+
+#include <algorithm>
+#include <sstream>
+#include <typeinfo>
+#include <sys/time.h>
+#include <time.h>
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+EventProfiler::EventProfiler ()
+  : m_start (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+EventProfiler::GetNanoSeconds (void)
+{
+#if defined (HAVE_RT) && defined (CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+  struct timeval tv;
+  gettimeofday (&tv, 0);
+  return tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+#endif
+}
+
+void
+EventProfiler::Start (void)
+{
+  m_start = GetNanoSeconds ();
+}
+
+void
+EventProfiler::Stop (uint32_t context, const EventImpl *event)
+{
+  uint64_t ns = GetNanoSeconds () - m_start;
+  Entry &entry = m_entries[std::make_pair (context, LookupCallback (event))];
+  entry.count++;
+  entry.ns += ns;
+}
+
+uint32_t
+EventProfiler::LookupCallback (const EventImpl *event)
+{
+  // type_info names are unique strings: compare their addresses
+  const char *type = typeid (*event).name ();
+  std::map<const char *, uint32_t>::const_iterator i = m_types.find (type);
+  if (i != m_types.end ())
+    {
+      return i->second;
+    }
+  uint32_t index = m_callbacks.size ();
+  m_callbacks.push_back (GetCallbackName (event));
+  m_types[type] = index;
+  return index;
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_entries.clear ();
+}
+
+std::string
+EventProfiler::GetCallbackName (const EventImpl *event)
+{
+  std::string name = typeid (*event).name ();
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+
+  // The events created by MakeEvent are local classes, such as
+  // "ns3::MakeEvent<...>(void (ns3::A::*)(int), ns3::A*, int)::EventMemberImpl1":
+  // keep the type of the first parameter of MakeEvent.
+  std::string::size_type i = name.find ("MakeEvent");
+  if (i == std::string::npos)
+    {
+      return name;
+    }
+  i += 9;
+  int depth = 0;
+  while (i < name.size () && (name[i] != '(' || depth != 0))
+    {
+      if (name[i] == '<')
+        {
+          depth++;
+        }
+      else if (name[i] == '>')
+        {
+          depth--;
+        }
+      i++;
+    }
+  std::string::size_type start = ++i;
+  depth = 0;
+  while (i < name.size ())
+    {
+      char c = name[i];
+      if (c == '(' || c == '<')
+        {
+          depth++;
+        }
+      else if ((c == ')' || c == '>') && depth > 0)
+        {
+          depth--;
+        }
+      else if ((c == ')' || c == ',') && depth == 0)
+        {
+          return name.substr (start, i - start);
+        }
+      i++;
+    }
+  return name;
+}
+
+std::string
+EventProfiler::GetModuleName (std::string callback)
+{
+  // member function pointers read "R (ns3::A::*)(...)"
+  std::string::size_type end = callback.find ("::*)");
+  if (end == std::string::npos)
+    {
+      return "unknown";
+    }
+  std::string::size_type start = callback.rfind ('(', end);
+  if (start == std::string::npos)
+    {
+      return "unknown";
+    }
+  TypeId tid;
+  if (!TypeId::LookupByNameFailSafe (callback.substr (start + 1, end - start - 1), &tid))
+    {
+      return "unknown";
+    }
+  while (tid.GetGroupName ().empty () && tid.HasParent () && tid.GetParent () != tid)
+    {
+      tid = tid.GetParent ();
+    }
+  if (tid.GetGroupName ().empty ())
+    {
+      return "unknown";
+    }
+  return tid.GetGroupName ();
+}
+
+bool
+EventProfiler::CompareRows (const Row &a, const Row &b)
+{
+  if (a.second.ns != b.second.ns)
+    {
+      return a.second.ns > b.second.ns;
+    }
+  return a.first < b.first;
+}
+
+void
+EventProfiler::WriteCsv (std::ostream &os, std::string category,
+                         std::vector<Row> rows, uint64_t total)
+{
+  std::sort (rows.begin (), rows.end (), &EventProfiler::CompareRows);
+  for (std::vector<Row>::const_iterator i = rows.begin (); i != rows.end (); ++i)
+    {
+      os << category << ",\"" << i->first << "\","
+         << i->second.count << ","
+         << i->second.ns / 1e9 << ","
+         << (total == 0 ? 0.0 : 100.0 * i->second.ns / total)
+         << std::endl;
+    }
+}
+
+void
+EventProfiler::Write (std::ostream &os, enum Format format) const
+{
+  NS_LOG_FUNCTION (this << &os << format);
+  std::map<std::string, Entry> modules;
+  std::map<std::string, Entry> nodes;
+  std::map<std::string, Entry> callbacks;
+  std::map<std::string, Entry> stacks;
+  uint64_t total = 0;
+  for (std::map<std::pair<uint32_t, uint32_t>, Entry>::const_iterator i = m_entries.begin ();
+       i != m_entries.end (); ++i)
+    {
+      const std::string &callback = m_callbacks[i->first.second];
+      std::string module = GetModuleName (callback);
+      std::ostringstream node;
+      if (i->first.first == 0xffffffff)
+        {
+          node << "none";
+        }
+      else
+        {
+          node << i->first.first;
+        }
+      Entry *entries[] = {
+        &modules[module],
+        &nodes[node.str ()],
+        &callbacks[callback],
+        &stacks[module + ";" + callback]
+      };
+      for (uint32_t j = 0; j < sizeof (entries) / sizeof (entries[0]); j++)
+        {
+          entries[j]->count += i->second.count;
+          entries[j]->ns += i->second.ns;
+        }
+      total += i->second.ns;
+    }
+
+  if (format == COLLAPSED)
+    {
+      for (std::map<std::string, Entry>::const_iterator i = stacks.begin (); i != stacks.end (); ++i)
+        {
+          os << i->first << " " << i->second.ns << std::endl;
+        }
+      return;
+    }
+  os << "category,name,events,seconds,percent" << std::endl;
+  WriteCsv (os, "module", std::vector<Row> (modules.begin (), modules.end ()), total);
+  WriteCsv (os, "node", std::vector<Row> (nodes.begin (), nodes.end ()), total);
+  WriteCsv (os, "callback", std::vector<Row> (callbacks.begin (), callbacks.end ()), total);
+}
+
+} // namespace ns3
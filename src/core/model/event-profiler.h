@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declarations.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief Measure the wall-clock time spent in each event.
+ *
+ * The time is accumulated by node context and by callback.  The
+ * callback of an event is identified by the dynamic type of its
+ * EventImpl: for the events created by MakeEvent, this is the type of
+ * the bound function or member function, for instance
+ * <tt>void (ns3::WifiPhy::*)(ns3::Ptr<ns3::Packet>)</tt>.  The module
+ * of a member function callback is the group name of the TypeId of
+ * its class, when the class has one.
+ *
+ * DefaultSimulatorImpl uses this class when its ProfileFile attribute
+ * is set; see there.
+ */
+class EventProfiler
+{
+public:
+  /** The output formats of the report. */
+  enum Format
+  {
+    /**
+     * Comma-separated values, with one line per module, per node and
+     * per callback, each group ranked by decreasing time.
+     */
+    CSV,
+    /**
+     * Collapsed stacks, as read by flamegraph.pl: one line per
+     * module and callback, followed by the time in nanoseconds.
+     */
+    COLLAPSED
+  };
+
+  EventProfiler ();
+
+  /** Start the measure of an event. */
+  void Start (void);
+  /**
+   * Stop the measure of an event and record it.
+   *
+   * \param [in] context The context of the event.
+   * \param [in] event The event.
+   */
+  void Stop (uint32_t context, const EventImpl *event);
+  /**
+   * Write the report of the events recorded so far.
+   *
+   * \param [in,out] os The output stream.
+   * \param [in] format The output format.
+   */
+  void Write (std::ostream &os, enum Format format) const;
+  /** Forget the events recorded so far. */
+  void Clear (void);
+
+  /**
+   * \param [in] event An event.
+   * \returns The name of the callback of the event.
+   */
+  static std::string GetCallbackName (const EventImpl *event);
+  /**
+   * \param [in] callback The name of the callback of an event.
+   * \returns The name of the module of the callback, or "unknown".
+   */
+  static std::string GetModuleName (std::string callback);
+
+private:
+  /** The statistics of a group of events. */
+  struct Entry
+  {
+    uint64_t count;  //!< Number of events
+    uint64_t ns;     //!< Time spent in the events, in nanoseconds
+  };
+  /** A named Entry, to rank them. */
+  typedef std::pair<std::string, Entry> Row;
+
+  /**
+   * \param [in] a A row.
+   * \param [in] b Another row.
+   * \returns \c true if a ranks before b.
+   */
+  static bool CompareRows (const Row &a, const Row &b);
+  /**
+   * Write a group of rows in CSV, ranked by decreasing time.
+   *
+   * \param [in,out] os The output stream.
+   * \param [in] category The name of the group.
+   * \param [in] rows The rows.
+   * \param [in] total The total time, in nanoseconds.
+   */
+  static void WriteCsv (std::ostream &os, std::string category,
+                        std::vector<Row> rows, uint64_t total);
+  /** \returns The current value of the wall clock, in nanoseconds. */
+  static uint64_t GetNanoSeconds (void);
+  /**
+   * \param [in] event An event.
+   * \returns The index of its callback in m_callbacks.
+   */
+  uint32_t LookupCallback (const EventImpl *event);
+
+  /** Wall-clock time at the last call to Start. */
+  uint64_t m_start;
+  /** The callback indexes, by C++ type name. */
+  std::map<const char *, uint32_t> m_types;
+  /** The callback names. */
+  std::vector<std::string> m_callbacks;
+  /** The statistics, by context and callback index. */
+  std::map<std::pair<uint32_t, uint32_t>, Entry> m_entries;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -150,10 +150,10 @@ HeapScheduler::IsEmpty (void) const
 }
 
 void
-HeapScheduler::BottomUp (void)
+HeapScheduler::BottomUp (uint32_t start)
 {
-  NS_LOG_FUNCTION (this);
-  uint32_t index = Last ();
+  NS_LOG_FUNCTION (this << start);
+  uint32_t index = start;
   while (!IsRoot (index)
          && IsLessStrictly (index, Parent (index)))
     {
@@ -203,7 +203,56 @@ HeapScheduler::Insert (const Event &ev)
 {
   NS_LOG_FUNCTION (this << &ev);
   m_heap.push_back (ev);
-  BottomUp ();
+  BottomUp (Last ());
+}
+
+void
+HeapScheduler::InsertBatch (const std::vector<Scheduler::Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  uint32_t size = Last ();
+  if (events.size () < size)
+    {
+      for (std::vector<Scheduler::Event>::const_iterator i = events.begin (); i != events.end (); ++i)
+        {
+          Insert (*i);
+        }
+      return;
+    }
+  // a large batch: rebuild the whole heap in linear time
+  m_heap.insert (m_heap.end (), events.begin (), events.end ());
+  Rebuild ();
+}
+
+void
+HeapScheduler::RemoveCancelled (std::vector<Scheduler::Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t last = Root ();
+  for (uint32_t i = Root (); i < m_heap.size (); i++)
+    {
+      if (m_heap[i].impl->IsCancelled ())
+        {
+          cancelled.push_back (m_heap[i]);
+        }
+      else
+        {
+          m_heap[last] = m_heap[i];
+          last++;
+        }
+    }
+  m_heap.resize (last);
+  Rebuild ();
+}
+
+void
+HeapScheduler::Rebuild (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t index = Last () / 2; index >= Root (); index--)
+    {
+      TopDown (index);
+    }
 }
 
 Scheduler::Event
@@ -236,7 +285,12 @@ HeapScheduler::Remove (const Event &ev)
           NS_ASSERT (m_heap[i].impl == ev.impl);
           Exch (i, Last ());
           m_heap.pop_back ();
-          TopDown (i);
+          // the former last item may belong above or below i
+          if (i < m_heap.size ())
+            {
+              TopDown (i);
+              BottomUp (i);
+            }
           return;
         }
     }
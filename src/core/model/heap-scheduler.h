@@ -66,6 +66,8 @@ public:
 
   // Inherited
   virtual void Insert (const Scheduler::Event &ev);
+  virtual void InsertBatch (const std::vector<Scheduler::Event> &events);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &cancelled);
   virtual bool IsEmpty (void) const;
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
@@ -151,14 +153,20 @@ private:
    * \param [in] b The second item.
    */
   inline void Exch (uint32_t a, uint32_t b);
-  /** Percolate a newly inserted Last item to its proper position. */ 
-  void BottomUp (void);
+  /**
+   * Percolate an item up to its proper position.
+   *
+   * \param [in] start The item to percolate.
+   */
+  void BottomUp (uint32_t start);
   /**
    * Percolate a deletion bubble down the heap.
    *
    * \param [in] start Starting entry.
    */
   void TopDown (uint32_t start);
+  /** Restore the heap property of the whole heap, in linear time. */
+  void Rebuild (void);
 
   /** The event list. */
   BinaryHeap m_heap;
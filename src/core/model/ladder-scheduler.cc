@@ -0,0 +1,341 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (std::numeric_limits<uint64_t>::max ()),
+    m_topMax (0),
+    m_nRungs (0),
+    m_bottomHead (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+  // rungs are never reallocated so that references to them stay valid.
+  m_rungs.resize (MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LadderScheduler::InitRung (Rung &rung, uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << start << width << nBuckets);
+  rung.start = start;
+  rung.width = width;
+  rung.nBuckets = nBuckets;
+  rung.current = 0;
+  if (rung.buckets.size () < nBuckets)
+    {
+      rung.buckets.resize (nBuckets);
+    }
+}
+
+LadderScheduler::Bucket *
+LadderScheduler::FindBucket (uint64_t ts)
+{
+  if (ts >= m_topStart)
+    {
+      return &m_top;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= rung.start + rung.current * rung.width)
+        {
+          uint64_t bucket = (ts - rung.start) / rung.width;
+          NS_ASSERT (bucket < rung.nBuckets);
+          return &rung.buckets[bucket];
+        }
+    }
+  return 0;
+}
+
+void
+LadderScheduler::InsertBottom (const Scheduler::Event &ev)
+{
+  Bucket::iterator i = std::upper_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (), ev);
+  m_bottom.insert (i, ev);
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  m_size++;
+  if (m_size == 1)
+    {
+      // the bottom is never empty when there are pending events
+      m_bottom.push_back (ev);
+      m_topStart = ev.key.m_ts + 1;
+      return;
+    }
+  Bucket *bucket = FindBucket (ev.key.m_ts);
+  if (bucket == 0)
+    {
+      InsertBottom (ev);
+      return;
+    }
+  if (bucket == &m_top)
+    {
+      m_topMin = std::min (m_topMin, ev.key.m_ts);
+      m_topMax = std::max (m_topMax, ev.key.m_ts);
+    }
+  bucket->push_back (ev);
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom[m_bottomHead];
+  m_bottomHead++;
+  m_size--;
+  if (m_bottomHead == m_bottom.size ())
+    {
+      Refill ();
+    }
+  NS_LOG_DEBUG ("remove " << ev.impl << ", time=" << ev.key.m_ts << ", uid=" << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  m_size--;
+  Bucket *bucket = FindBucket (ev.key.m_ts);
+  if (bucket == 0)
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin () + m_bottomHead, m_bottom.end (), ev);
+      NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+      m_bottom.erase (i);
+      if (m_bottomHead == m_bottom.size ())
+        {
+          Refill ();
+        }
+      return;
+    }
+  for (Bucket::iterator i = bucket->begin (); i != bucket->end (); i++)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == i->impl);
+          // buckets are not sorted: fill the hole with the last event
+          *i = bucket->back ();
+          bucket->pop_back ();
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+void
+LadderScheduler::RemoveCancelled (std::vector<Scheduler::Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t before = cancelled.size ();
+  // the bottom stays sorted; drop its already dequeued events as well
+  Bucket::iterator last = m_bottom.begin ();
+  for (Bucket::iterator i = m_bottom.begin () + m_bottomHead; i != m_bottom.end (); i++)
+    {
+      if (i->impl->IsCancelled ())
+        {
+          cancelled.push_back (*i);
+        }
+      else
+        {
+          *last = *i;
+          last++;
+        }
+    }
+  m_bottom.erase (last, m_bottom.end ());
+  m_bottomHead = 0;
+  RemoveCancelledFrom (m_top, cancelled);
+  for (uint32_t r = 0; r < m_nRungs; r++)
+    {
+      Rung &rung = m_rungs[r];
+      for (uint32_t b = rung.current; b < rung.nBuckets; b++)
+        {
+          RemoveCancelledFrom (rung.buckets[b], cancelled);
+        }
+    }
+  m_size -= cancelled.size () - before;
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+void
+LadderScheduler::RemoveCancelledFrom (Bucket &bucket, std::vector<Scheduler::Event> &cancelled)
+{
+  Bucket::iterator last = bucket.begin ();
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      if (i->impl->IsCancelled ())
+        {
+          cancelled.push_back (*i);
+        }
+      else
+        {
+          *last = *i;
+          last++;
+        }
+    }
+  bucket.erase (last, bucket.end ());
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_bottom.clear ();
+  m_bottomHead = 0;
+  if (m_size == 0)
+    {
+      m_nRungs = 0;
+      m_topMin = std::numeric_limits<uint64_t>::max ();
+      m_topMax = 0;
+      return;
+    }
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          TransferTop ();
+          continue;
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+        {
+          rung.current++;
+        }
+      if (rung.current == rung.nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t start = rung.start + rung.current * rung.width;
+      rung.current++;
+      if (bucket.size () > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          SpawnRung (bucket, start, rung.width);
+          continue;
+        }
+      // swap rather than copy so that the bucket recycles the
+      // storage of the previous bottom.
+      m_bottom.swap (bucket);
+      std::sort (m_bottom.begin (), m_bottom.end ());
+    }
+}
+
+void
+LadderScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size () << m_topMin << m_topMax);
+  NS_ASSERT (!m_top.empty () && m_nRungs == 0);
+  if (m_top.size () <= THRESHOLD)
+    {
+      m_bottom.swap (m_top);
+      std::sort (m_bottom.begin (), m_bottom.end ());
+      m_topStart = m_topMax + 1;
+    }
+  else
+    {
+      uint64_t range = m_topMax - m_topMin;
+      uint32_t nBuckets = std::min<uint64_t> (std::min<uint64_t> (m_top.size (), MAX_BUCKETS), range + 1);
+      uint64_t width = range / nBuckets + 1;
+      Rung &rung = m_rungs[0];
+      InitRung (rung, m_topMin, width, nBuckets);
+      m_nRungs = 1;
+      for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); i++)
+        {
+          rung.buckets[(i->key.m_ts - rung.start) / width].push_back (*i);
+        }
+      m_top.clear ();
+      m_topStart = rung.start + width * nBuckets;
+    }
+  m_topMin = std::numeric_limits<uint64_t>::max ();
+  m_topMax = 0;
+}
+
+void
+LadderScheduler::SpawnRung (Bucket &bucket, uint64_t start, uint64_t width)
+{
+  NS_LOG_FUNCTION (this << bucket.size () << start << width);
+  uint32_t nBuckets = std::min<uint64_t> (std::min<uint64_t> (bucket.size (), MAX_BUCKETS), width);
+  uint64_t childWidth = (width + nBuckets - 1) / nBuckets;
+  Rung &rung = m_rungs[m_nRungs];
+  InitRung (rung, start, childWidth, nBuckets);
+  m_nRungs++;
+  for (Bucket::const_iterator i = bucket.begin (); i != bucket.end (); i++)
+    {
+      rung.buckets[(i->key.m_ts - start) / childWidth].push_back (*i);
+    }
+  bucket.clear ();
+}
+
+} // namespace ns3
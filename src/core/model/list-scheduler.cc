@@ -21,6 +21,7 @@
 #include "list-scheduler.h"
 #include "event-impl.h"
 #include "log.h"
+#include <algorithm>
 #include <utility>
 #include <string>
 #include "assert.h"
@@ -70,6 +71,41 @@ ListScheduler::Insert (const Event &ev)
     }
   m_events.push_back (ev);
 }
+void
+ListScheduler::InsertBatch (const std::vector<Scheduler::Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  // merge the sorted batch with the list in a single pass
+  std::vector<Scheduler::Event> sorted (events);
+  std::sort (sorted.begin (), sorted.end ());
+  EventsI i = m_events.begin ();
+  for (std::vector<Scheduler::Event>::const_iterator j = sorted.begin (); j != sorted.end (); ++j)
+    {
+      while (i != m_events.end () && !(j->key < i->key))
+        {
+          i++;
+        }
+      m_events.insert (i, *j);
+    }
+}
+void
+ListScheduler::RemoveCancelled (std::vector<Scheduler::Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  EventsI i = m_events.begin ();
+  while (i != m_events.end ())
+    {
+      if (i->impl->IsCancelled ())
+        {
+          cancelled.push_back (*i);
+          i = m_events.erase (i);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
 bool
 ListScheduler::IsEmpty (void) const
 {
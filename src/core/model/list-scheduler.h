@@ -23,6 +23,7 @@
 
 #include "scheduler.h"
 #include <list>
+#include <vector>
 #include <utility>
 #include <stdint.h>
 
@@ -59,6 +60,8 @@ public:
 
   // Inherited
   virtual void Insert (const Scheduler::Event &ev);
+  virtual void InsertBatch (const std::vector<Scheduler::Event> &events);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &cancelled);
   virtual bool IsEmpty (void) const;
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
@@ -23,6 +23,7 @@
 #include "event-impl.h"
 #include "assert.h"
 #include "log.h"
+#include <algorithm>
 #include <string>
 
 /**
@@ -66,6 +67,43 @@ MapScheduler::Insert (const Event &ev)
   NS_ASSERT (result.second);
 }
 
+void
+MapScheduler::InsertBatch (const std::vector<Scheduler::Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  // once sorted, each event is inserted right after the previous one
+  std::vector<Scheduler::Event> sorted (events);
+  std::sort (sorted.begin (), sorted.end ());
+  EventMapI hint = m_list.begin ();
+  for (std::vector<Scheduler::Event>::const_iterator i = sorted.begin (); i != sorted.end (); ++i)
+    {
+      hint = m_list.insert (hint, std::make_pair (i->key, i->impl));
+      NS_ASSERT (hint->second == i->impl);
+    }
+}
+
+void
+MapScheduler::RemoveCancelled (std::vector<Scheduler::Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  EventMapI i = m_list.begin ();
+  while (i != m_list.end ())
+    {
+      if (i->second->IsCancelled ())
+        {
+          Scheduler::Event ev;
+          ev.impl = i->second;
+          ev.key = i->first;
+          cancelled.push_back (ev);
+          m_list.erase (i++);
+        }
+      else
+        {
+          i++;
+        }
+    }
+}
+
 bool
 MapScheduler::IsEmpty (void) const
 {
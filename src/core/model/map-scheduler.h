@@ -25,6 +25,7 @@
 #include <stdint.h>
 #include <map>
 #include <utility>
+#include <vector>
 
 /**
  * \file
@@ -57,6 +58,8 @@ public:
 
   // Inherited
   virtual void Insert (const Scheduler::Event &ev);
+  virtual void InsertBatch (const std::vector<Scheduler::Event> &events);
+  virtual void RemoveCancelled (std::vector<Scheduler::Event> &cancelled);
   virtual bool IsEmpty (void) const;
   virtual Scheduler::Event PeekNext (void) const;
   virtual Scheduler::Event RemoveNext (void);
@@ -0,0 +1,922 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "multithreaded-simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ptr.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "abort.h"
+#include "log.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+/** Timestamp meaning "never". */
+static const uint64_t NO_TIMESTAMP = std::numeric_limits<uint64_t>::max ();
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("ThreadCount",
+                   "The number of threads processing partitions, "
+                   "0 to use one thread per online processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::SetThreadCount,
+                                         &MultithreadedSimulatorImpl::GetThreadCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PartitionCount",
+                   "The number of partitions the contexts are split into, "
+                   "0 to use one partition per thread.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::SetPartitionCount,
+                                         &MultithreadedSimulatorImpl::GetPartitionCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("LookAhead",
+                   "The smallest delay of an event scheduled from one "
+                   "partition to another.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::SetLookAhead,
+                                     &MultithreadedSimulatorImpl::GetLookAhead),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  m_partitionCount = 0;
+  m_threadCount = 0;
+  m_lookAhead = Seconds (0);
+  m_stop = false;
+  m_stopTs = NO_TIMESTAMP;
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  m_uid = 4;
+  m_currentTs = 0;
+  m_unscheduledEvents = 0;
+  m_windowEnd = 0;
+  m_windowCount = 0;
+  m_main = SystemThread::Self ();
+
+  pthread_key_create (&m_currentPartition, 0);
+  pthread_mutex_init (&m_mutex, 0);
+  pthread_cond_init (&m_phaseStart, 0);
+  pthread_cond_init (&m_phaseDone, 0);
+  m_phase = PHASE_EXIT;
+  m_generation = 0;
+  m_nextPartition = 0;
+  m_busyWorkers = 0;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  pthread_cond_destroy (&m_phaseDone);
+  pthread_cond_destroy (&m_phaseStart);
+  pthread_mutex_destroy (&m_mutex);
+  pthread_key_delete (m_currentPartition);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_events->IsEmpty ())
+    {
+      Scheduler::Event next = m_events->RemoveNext ();
+      next.impl->Unref ();
+    }
+  m_events = 0;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *partition = *i;
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (std::vector<RemoteEvents>::iterator j = partition->outbox.begin (); j != partition->outbox.end (); ++j)
+        {
+          for (RemoteEvents::iterator k = j->begin (); k != j->end (); ++k)
+            {
+              k->event->Unref ();
+            }
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+
+  Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+  if (m_events != 0)
+    {
+      while (!m_events->IsEmpty ())
+        {
+          scheduler->Insert (m_events->RemoveNext ());
+        }
+    }
+  m_events = scheduler;
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!(*i)->events->IsEmpty ())
+        {
+          scheduler->Insert ((*i)->events->RemoveNext ());
+        }
+      (*i)->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << context << partition);
+  NS_ABORT_MSG_UNLESS (m_partitions.empty (),
+                       "The partition map cannot be changed after Simulator::Run");
+  m_partitionMap[context] = partition;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (!m_partitions.empty ())
+    {
+      return PeekPartition (context)->index;
+    }
+  if (context == 0xffffffff)
+    {
+      return 0;
+    }
+  std::map<uint32_t, uint32_t>::const_iterator i = m_partitionMap.find (context);
+  if (i != m_partitionMap.end ())
+    {
+      return i->second;
+    }
+  return context % GetPartitionCount ();
+}
+
+void
+MultithreadedSimulatorImpl::SetPartitionCount (uint32_t count)
+{
+  NS_LOG_FUNCTION (this << count);
+  NS_ABORT_MSG_UNLESS (m_partitions.empty (),
+                       "The partition count cannot be changed after Simulator::Run");
+  m_partitionCount = count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount (void) const
+{
+  if (!m_partitions.empty ())
+    {
+      return m_partitions.size ();
+    }
+  if (m_partitionCount == 0)
+    {
+      return GetThreadCount ();
+    }
+  return m_partitionCount;
+}
+
+void
+MultithreadedSimulatorImpl::SetThreadCount (uint32_t count)
+{
+  NS_LOG_FUNCTION (this << count);
+  m_threadCount = count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetThreadCount (void) const
+{
+  if (m_threadCount == 0)
+    {
+      long processors = sysconf (_SC_NPROCESSORS_ONLN);
+      return processors > 0 ? processors : 1;
+    }
+  return m_threadCount;
+}
+
+void
+MultithreadedSimulatorImpl::SetLookAhead (const Time &lookAhead)
+{
+  NS_LOG_FUNCTION (this << lookAhead);
+  NS_ABORT_MSG_IF (lookAhead.IsStrictlyNegative (), "The lookahead cannot be negative");
+  m_lookAhead = lookAhead;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead (void) const
+{
+  return m_lookAhead;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount (void) const
+{
+  return m_windowCount;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetRemoteEventCount (void) const
+{
+  uint64_t count = 0;
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      count += (*i)->remoteEvents;
+    }
+  return count;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::PeekCurrentPartition (void) const
+{
+  return static_cast<Partition *> (pthread_getspecific (m_currentPartition));
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::PeekPartition (uint32_t context) const
+{
+  if (context < m_contextPartition.size ())
+    {
+      return m_partitions[m_contextPartition[context]];
+    }
+  if (context == 0xffffffff)
+    {
+      return m_partitions[0];
+    }
+  return m_partitions[context % m_partitions.size ()];
+}
+
+void
+MultithreadedSimulatorImpl::SetupPartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_partitions.empty ())
+    {
+      uint32_t count = GetPartitionCount ();
+      NS_ASSERT (count > 0);
+      NS_ABORT_MSG_IF (count > 1 && m_lookAhead.IsZero (),
+                       "MultithreadedSimulatorImpl needs a strictly positive LookAhead "
+                       "to run more than one partition");
+
+      std::map<uint32_t, uint32_t>::const_iterator last = m_partitionMap.end ();
+      if (!m_partitionMap.empty ())
+        {
+          --last;
+          m_contextPartition.resize (last->first + 1);
+        }
+      for (uint32_t context = 0; context < m_contextPartition.size (); ++context)
+        {
+          m_contextPartition[context] = context % count;
+        }
+      for (std::map<uint32_t, uint32_t>::const_iterator i = m_partitionMap.begin (); i != m_partitionMap.end (); ++i)
+        {
+          NS_ABORT_MSG_UNLESS (i->second < count, "Context " << i->first << " is mapped to partition "
+                               << i->second << " but there are only " << count << " partitions");
+          m_contextPartition[i->first] = i->second;
+        }
+
+      for (uint32_t i = 0; i < count; ++i)
+        {
+          Partition *partition = new Partition ();
+          partition->index = i;
+          partition->events = m_schedulerFactory.Create<Scheduler> ();
+          partition->uid = m_uid;
+          partition->currentUid = 0;
+          partition->currentTs = m_currentTs;
+          partition->currentContext = 0xffffffff;
+          partition->unscheduledEvents = 0;
+          partition->stop = false;
+          partition->stopTs = NO_TIMESTAMP;
+          partition->remoteEvents = 0;
+          partition->outbox.resize (count);
+          m_partitions.push_back (partition);
+        }
+    }
+
+  while (!m_events->IsEmpty ())
+    {
+      Scheduler::Event ev = m_events->RemoveNext ();
+      m_unscheduledEvents--;
+      Insert (ev);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::AllocateUid (uint32_t context)
+{
+  if (m_partitions.empty ())
+    {
+      return m_uid++;
+    }
+  return PeekPartition (context)->uid++;
+}
+
+void
+MultithreadedSimulatorImpl::Insert (const Scheduler::Event &ev)
+{
+  if (m_partitions.empty ())
+    {
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+    }
+  else
+    {
+      Partition *partition = PeekPartition (ev.key.m_context);
+      partition->unscheduledEvents++;
+      partition->events->Insert (ev);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ExecutePartition (Partition *partition)
+{
+  uint64_t end = m_windowEnd;
+  while (!partition->stop && !partition->events->IsEmpty ())
+    {
+      if (partition->stopTs < end)
+        {
+          end = partition->stopTs + 1;
+        }
+      if (partition->events->PeekNext ().key.m_ts >= end)
+        {
+          break;
+        }
+      Scheduler::Event next = partition->events->RemoveNext ();
+
+      NS_ASSERT (next.key.m_ts >= partition->currentTs);
+      partition->unscheduledEvents--;
+
+      partition->currentTs = next.key.m_ts;
+      partition->currentContext = next.key.m_context;
+      partition->currentUid = next.key.m_uid;
+      next.impl->Invoke ();
+      next.impl->Unref ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ReceivePartition (Partition *partition)
+{
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      RemoteEvents &events = (*i)->outbox[partition->index];
+      for (RemoteEvents::const_iterator j = events.begin (); j != events.end (); ++j)
+        {
+          NS_ASSERT (j->timestamp >= partition->currentTs);
+          Scheduler::Event ev;
+          ev.impl = j->event;
+          ev.key.m_ts = j->timestamp;
+          ev.key.m_context = j->context;
+          ev.key.m_uid = partition->uid;
+          partition->uid++;
+          partition->unscheduledEvents++;
+          partition->events->Insert (ev);
+        }
+      partition->remoteEvents += events.size ();
+      events.clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Dispatch (enum Phase phase)
+{
+  pthread_mutex_lock (&m_mutex);
+  m_phase = phase;
+  m_nextPartition = 0;
+  m_busyWorkers = m_workers.size ();
+  m_generation++;
+  pthread_cond_broadcast (&m_phaseStart);
+  pthread_mutex_unlock (&m_mutex);
+
+  if (phase != PHASE_EXIT)
+    {
+      // the main thread takes its share of the partitions too.
+      DoPhase ();
+    }
+
+  pthread_mutex_lock (&m_mutex);
+  while (m_busyWorkers > 0)
+    {
+      pthread_cond_wait (&m_phaseDone, &m_mutex);
+    }
+  pthread_mutex_unlock (&m_mutex);
+}
+
+void
+MultithreadedSimulatorImpl::DoPhase (void)
+{
+  while (true)
+    {
+      pthread_mutex_lock (&m_mutex);
+      uint32_t index = m_nextPartition;
+      m_nextPartition++;
+      enum Phase phase = m_phase;
+      pthread_mutex_unlock (&m_mutex);
+
+      if (index >= m_partitions.size ())
+        {
+          return;
+        }
+      Partition *partition = m_partitions[index];
+      pthread_setspecific (m_currentPartition, partition);
+      switch (phase)
+        {
+        case PHASE_EXECUTE:
+          ExecutePartition (partition);
+          break;
+        case PHASE_RECEIVE:
+          ReceivePartition (partition);
+          break;
+        default:
+          NS_ASSERT (false);
+          break;
+        }
+      pthread_setspecific (m_currentPartition, 0);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop (void)
+{
+  // workers are started before the first Dispatch of a Run.
+  uint64_t generation = 0;
+  while (true)
+    {
+      pthread_mutex_lock (&m_mutex);
+      while (m_generation == generation)
+        {
+          pthread_cond_wait (&m_phaseStart, &m_mutex);
+        }
+      generation = m_generation;
+      enum Phase phase = m_phase;
+      pthread_mutex_unlock (&m_mutex);
+
+      if (phase != PHASE_EXIT)
+        {
+          DoPhase ();
+        }
+
+      pthread_mutex_lock (&m_mutex);
+      m_busyWorkers--;
+      if (m_busyWorkers == 0)
+        {
+          pthread_cond_signal (&m_phaseDone);
+        }
+      pthread_mutex_unlock (&m_mutex);
+
+      if (phase == PHASE_EXIT)
+        {
+          return;
+        }
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return m_events->IsEmpty ();
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = SystemThread::Self ();
+  SetupPartitions ();
+  m_stop = false;
+
+  uint32_t threads = std::min (GetThreadCount (), GetPartitionCount ());
+  m_generation = 0;
+  for (uint32_t i = 1; i < threads; ++i)
+    {
+      Ptr<SystemThread> worker = Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::WorkerLoop, this));
+      worker->Start ();
+      m_workers.push_back (worker);
+    }
+  NS_LOG_LOGIC ("running " << m_partitions.size () << " partitions on " << threads << " threads");
+
+  uint64_t lookAhead = m_lookAhead.GetTimeStep ();
+  bool stopTimeReached = false;
+  while (!m_stop)
+    {
+      uint64_t next = NO_TIMESTAMP;
+      for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          Partition *partition = *i;
+          m_stop = m_stop || partition->stop;
+          partition->stop = false;
+          m_stopTs = std::min (m_stopTs, partition->stopTs);
+          partition->stopTs = NO_TIMESTAMP;
+          if (!partition->events->IsEmpty ())
+            {
+              next = std::min (next, partition->events->PeekNext ().key.m_ts);
+            }
+        }
+      if (m_stop || next == NO_TIMESTAMP)
+        {
+          break;
+        }
+      if (next > m_stopTs)
+        {
+          stopTimeReached = true;
+          break;
+        }
+
+      if (m_partitions.size () == 1 || lookAhead >= NO_TIMESTAMP - next)
+        {
+          m_windowEnd = NO_TIMESTAMP;
+        }
+      else
+        {
+          m_windowEnd = next + lookAhead;
+        }
+      if (m_stopTs < m_windowEnd)
+        {
+          m_windowEnd = m_stopTs + 1;
+        }
+
+      Dispatch (PHASE_EXECUTE);
+      Dispatch (PHASE_RECEIVE);
+      m_windowCount++;
+    }
+
+  Dispatch (PHASE_EXIT);
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_workers.begin (); i != m_workers.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_workers.clear ();
+
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *partition = *i;
+      if (stopTimeReached)
+        {
+          // every event up to the stop time has run: move the clock
+          // to the stop time, like the stop event would have done.
+          partition->currentTs = m_stopTs;
+          partition->currentUid = partition->uid - 1;
+        }
+      m_currentTs = std::max (m_currentTs, partition->currentTs);
+      m_uid = std::max (m_uid, partition->uid);
+
+      // If the simulator stopped naturally by lack of events, make a
+      // consistency test to check that we didn't lose any events along the way.
+      NS_ASSERT (!partition->events->IsEmpty () || partition->unscheduledEvents == 0);
+    }
+  if (stopTimeReached)
+    {
+      m_stopTs = NO_TIMESTAMP;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Partition *current = PeekCurrentPartition ();
+  if (current != 0)
+    {
+      current->stop = true;
+    }
+  else
+    {
+      m_stop = true;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  NS_ASSERT (!delay.IsStrictlyNegative ());
+  Partition *current = PeekCurrentPartition ();
+  if (current != 0)
+    {
+      current->stopTs = std::min<uint64_t> (current->stopTs, current->currentTs + delay.GetTimeStep ());
+    }
+  else
+    {
+      m_stopTs = std::min<uint64_t> (m_stopTs, m_currentTs + delay.GetTimeStep ());
+    }
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT (!delay.IsStrictlyNegative ());
+
+  Partition *current = PeekCurrentPartition ();
+  Scheduler::Event ev;
+  ev.impl = event;
+  if (current != 0)
+    {
+      ev.key.m_ts = current->currentTs + delay.GetTimeStep ();
+      ev.key.m_context = current->currentContext;
+      ev.key.m_uid = current->uid;
+      current->uid++;
+      current->unscheduledEvents++;
+      current->events->Insert (ev);
+    }
+  else
+    {
+      NS_ASSERT_MSG (SystemThread::Equals (m_main), "Simulator::Schedule Thread-unsafe invocation!");
+      ev.key.m_ts = m_currentTs + delay.GetTimeStep ();
+      ev.key.m_context = 0xffffffff;
+      ev.key.m_uid = AllocateUid (ev.key.m_context);
+      Insert (ev);
+    }
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  NS_ASSERT (!delay.IsStrictlyNegative ());
+
+  Partition *current = PeekCurrentPartition ();
+  if (current == 0)
+    {
+      NS_ASSERT_MSG (SystemThread::Equals (m_main),
+                     "MultithreadedSimulatorImpl does not support scheduling from foreign threads");
+      Scheduler::Event ev;
+      ev.impl = event;
+      ev.key.m_ts = m_currentTs + delay.GetTimeStep ();
+      ev.key.m_context = context;
+      ev.key.m_uid = AllocateUid (ev.key.m_context);
+      Insert (ev);
+      return;
+    }
+
+  Partition *target = PeekPartition (context);
+  if (target == current)
+    {
+      Scheduler::Event ev;
+      ev.impl = event;
+      ev.key.m_ts = current->currentTs + delay.GetTimeStep ();
+      ev.key.m_context = context;
+      ev.key.m_uid = current->uid;
+      current->uid++;
+      current->unscheduledEvents++;
+      current->events->Insert (ev);
+    }
+  else
+    {
+      NS_ABORT_MSG_IF (delay < m_lookAhead,
+                       "Event scheduled from context " << current->currentContext
+                       << " for context " << context << " with a delay of " << delay
+                       << ", lower than the lookahead " << m_lookAhead);
+      RemoteEvent ev;
+      ev.timestamp = current->currentTs + delay.GetTimeStep ();
+      ev.context = context;
+      ev.event = event;
+      current->outbox[target->index].push_back (ev);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (Seconds (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_ASSERT_MSG (SystemThread::Equals (m_main) && PeekCurrentPartition () == 0,
+                 "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+  EventId id (Ptr<EventImpl> (event, false), m_currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  m_uid++;
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  Partition *current = PeekCurrentPartition ();
+  if (current != 0)
+    {
+      return TimeStep (current->currentTs);
+    }
+  return TimeStep (m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  uint64_t now = Now ().GetTimeStep ();
+  if (IsExpired (id) || id.GetTs () < now)
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - now);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  if (m_partitions.empty ())
+    {
+      m_events->Remove (event);
+      m_unscheduledEvents--;
+    }
+  else
+    {
+      Partition *partition = PeekPartition (id.GetContext ());
+      NS_ASSERT_MSG (PeekCurrentPartition () == 0 || PeekCurrentPartition () == partition,
+                     "Simulator::Remove of an event owned by another partition");
+      partition->events->Remove (event);
+      partition->unscheduledEvents--;
+    }
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  if (m_partitions.empty ())
+    {
+      // nothing has run yet
+      return false;
+    }
+  const Partition *partition = PeekPartition (id.GetContext ());
+  if (id.GetTs () < partition->currentTs
+      || (id.GetTs () == partition->currentTs
+          && id.GetUid () <= partition->currentUid))
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *current = PeekCurrentPartition ();
+  if (current != 0)
+    {
+      return current->currentContext;
+    }
+  return 0xffffffff;
+}
+
+} // namespace ns3
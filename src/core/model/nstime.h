@@ -428,6 +428,10 @@ public:
    */
   inline static Time FromInteger (uint64_t value, enum Unit unit)
   {
+    if (g_nsResolution && unit <= NS)
+      {
+        return Time (value * GetNsPerUnit (unit));
+      }
     struct Information *info = PeekInformation (unit);
     if (info->fromMul)
       {
@@ -441,6 +445,17 @@ public:
   }
   inline static Time FromDouble (double value, enum Unit unit)
   {
+#if defined (INT64X64_USE_128) && !defined (PYTHON_SCAN)
+    if (g_nsResolution && unit <= NS)
+      {
+        // Same result as From(), which multiplies by the integer
+        // number of nanoseconds in the unit and truncates.
+        const int64x64_t v (value);
+        const uint128_t raw = (uint128_t (static_cast<uint64_t> (v.GetHigh ())) << 64) | v.GetLow ();
+        const int128_t ns = (static_cast<int128_t> (raw) * GetNsPerUnit (unit)) >> 64;
+        return Time (static_cast<int64_t> (ns));
+      }
+#endif
     return From (int64x64_t (value), unit);
   }
   inline static Time From (const int64x64_t & value, enum Unit unit)
@@ -476,6 +491,10 @@ public:
    */
   inline int64_t ToInteger (enum Unit unit) const
   {
+    if (g_nsResolution && unit <= NS)
+      {
+        return m_data / GetNsPerUnit (unit);
+      }
     struct Information *info = PeekInformation (unit);
     int64_t v = m_data;
     if (info->toMul)
@@ -490,6 +509,42 @@ public:
   }
   inline double ToDouble (enum Unit unit) const
   {
+#if defined (INT64X64_USE_128) && !defined (PYTHON_SCAN)
+    if (g_nsResolution && unit >= S && unit <= NS)
+      {
+        // Same result as To(), which multiplies by the 0.128 fixed point
+        // inverse of the number of nanoseconds in the unit (see
+        // int64x64_t::Invert), and int64x64_t::GetDouble.
+        uint64_t high = 0;
+        uint64_t low = 0;
+        switch (unit)
+          {
+          case S:
+            high = 0x000000044b82fa09ULL;
+            low = 0xb5a52cb98b405448ULL;
+            break;
+          case MS:
+            high = 0x000010c6f7a0b5edULL;
+            low = 0x8d36b4c7f3493859ULL;
+            break;
+          case US:
+            high = 0x004189374bc6a7efULL;
+            low = 0x9db22d0e56041894ULL;
+            break;
+          default:
+            return m_data;
+          }
+        const bool negative = m_data < 0;
+        const uint128_t a = negative ? -static_cast<int128_t> (m_data) : m_data;
+        const uint128_t value = a * high + ((a * low) >> 64);
+        const long double fhi = value >> 64;
+        const long double flo = static_cast<uint64_t> (value) / 18446744073709551616.0L;
+        long double retval = fhi;
+        retval += flo;
+        retval = negative ? -retval : retval;
+        return retval;
+      }
+#endif
     return To (unit).GetDouble ();
   }
   inline int64x64_t To (enum Unit unit) const
@@ -569,6 +624,45 @@ private:
     return & (PeekResolution ()->info[timeUnit]);
   }
 
+  /**
+   *  Get the number of nanoseconds in a unit, for the conversions with
+   *  the default resolution.
+   *
+   *  \param [in] unit A unit no finer than Time::NS.
+   *  eturn The number of nanoseconds in \p unit.
+   */
+  static inline int64_t GetNsPerUnit (enum Unit unit)
+  {
+    switch (unit)
+      {
+      case Y:
+        return 31536000000000000LL;
+      case D:
+        return 86400000000000LL;
+      case H:
+        return 3600000000000LL;
+      case MIN:
+        return 60000000000LL;
+      case S:
+        return 1000000000LL;
+      case MS:
+        return 1000000LL;
+      case US:
+        return 1000LL;
+      default:
+        return 1;
+      }
+  }
+
+  /**
+   *  \c true while the resolution is the default, Time::NS.
+   *
+   *  The conversions from and to the units no finer than Time::NS then
+   *  use inline integer arithmetic, with the same results as the
+   *  general int64x64_t path but without the Resolution table.
+   */
+  static bool g_nsResolution;
+
   /**
    *  Set the default resolution
    *
@@ -23,6 +23,7 @@
 #include "attribute-construction-list.h"
 #include "string.h"
 #include "ns3/core-config.h"
+#include <vector>
 #ifdef HAVE_STDLIB_H
 #include <cstdlib>
 #endif
@@ -79,96 +80,117 @@ ObjectBase::NotifyConstructionCompleted (void)
 void
 ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 {
-  // loop over the inheritance tree back to the Object base class.
+  // loop over the attributes of the object type and of its parents,
+  // back to the Object base class.
   NS_LOG_FUNCTION (this << &attributes);
   TypeId tid = GetInstanceTypeId ();
-  do {
-      // loop over all attributes in object type
-      NS_LOG_DEBUG ("construct tid="<<tid.GetName ()<<", params="<<tid.GetAttributeN ());
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+  Ptr<const TypeId::AttributeTable> table = tid.GetAttributeTable ();
+  NS_LOG_DEBUG ("construct tid="<<tid.GetName ()<<", params="<<table->attributes.size ());
+
+  // the values of the AttributeConstructionList, by attribute index
+  std::vector<Ptr<AttributeValue> > values;
+  for (AttributeConstructionList::CIterator j = attributes.Begin (); j != attributes.End (); ++j)
+    {
+      uint32_t i = table->Find (j->checker);
+      if (i != TypeId::AttributeTable::NOT_FOUND)
         {
-          struct TypeId::AttributeInformation info = tid.GetAttribute(i);
-          NS_LOG_DEBUG ("try to construct \""<< tid.GetName ()<<"::"<<
-                        info.name <<"\"");
-          // is this attribute stored in this AttributeConstructionList instance ?
-          Ptr<AttributeValue> value = attributes.Find(info.checker);
-          // See if this attribute should not be set here in the
-          // constructor.
-          if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+          values.resize (table->attributes.size ());
+          values[i] = j->value;
+        }
+    }
+
+  // the name and value pairs of the env var
+  std::vector<std::pair<std::string, std::string> > defaults;
+#ifdef HAVE_GETENV
+  char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+  if (envVar != 0)
+    {
+      std::string env = std::string (envVar);
+      std::string::size_type cur = 0;
+      std::string::size_type next = 0;
+      while (next != std::string::npos)
+        {
+          next = env.find (";", cur);
+          std::string tmp = std::string (env, cur, next-cur);
+          std::string::size_type equal = tmp.find ("=");
+          if (equal != std::string::npos)
             {
-              // Handle this attribute if it should not be 
-              // set here.
-              if (value == 0)
-                {
-                  // Skip this attribute if it's not in the
-                  // AttributeConstructionList.
-                  continue;
-                }              
-              else
-                {
-                  // This is an error because this attribute is not
-                  // settable in its constructor but is present in
-                  // the AttributeConstructionList.
-                  NS_FATAL_ERROR ("Attribute name="<<info.name<<" tid="<<tid.GetName () << ": initial value cannot be set using attributes");
-                }
+              std::string name = tmp.substr (0, equal);
+              std::string value = tmp.substr (equal+1, tmp.size () - equal - 1);
+              defaults.push_back (std::make_pair (name, value));
             }
-          bool found = false;
-          if (value != 0)
+          cur = next + 1;
+        }
+    }
+#endif /* HAVE_GETENV */
+
+  for (uint32_t i = 0; i < table->attributes.size (); i++)
+    {
+      const struct TypeId::AttributeTable::Attribute &attribute = table->attributes[i];
+      const struct TypeId::AttributeInformation &info = attribute.info;
+      NS_LOG_DEBUG ("try to construct \""<< attribute.fullName <<"\"");
+      // is this attribute stored in this AttributeConstructionList instance ?
+      Ptr<AttributeValue> value;
+      if (!values.empty ())
+        {
+          value = values[i];
+        }
+      // See if this attribute should not be set here in the
+      // constructor.
+      if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+        {
+          // Handle this attribute if it should not be 
+          // set here.
+          if (value == 0)
             {
-              // We have a matching attribute value.
-              if (DoSet (info.accessor, info.checker, *value))
-                {
-                  NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                                info.name<<"\"");
-                  found = true;
-                  continue;
-                }
+              // Skip this attribute if it's not in the
+              // AttributeConstructionList.
+              continue;
             }              
-          if (!found)
+          else
             {
-              // No matching attribute value so we try to look at the env var.
-#ifdef HAVE_GETENV
-              char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
-              if (envVar != 0)
+              // This is an error because this attribute is not
+              // settable in its constructor but is present in
+              // the AttributeConstructionList.
+              TypeId owner;
+              owner.SetUid (attribute.uid);
+              NS_FATAL_ERROR ("Attribute name="<<info.name<<" tid="<<owner.GetName () << ": initial value cannot be set using attributes");
+            }
+        }
+      bool found = false;
+      if (value != 0)
+        {
+          // We have a matching attribute value.
+          if (DoSet (info.accessor, info.checker, *value))
+            {
+              NS_LOG_DEBUG ("construct \""<< attribute.fullName <<"\"");
+              found = true;
+              continue;
+            }
+        }              
+      if (!found)
+        {
+          // No matching attribute value so we try to look at the env var.
+          for (uint32_t j = 0; j < defaults.size (); j++)
+            {
+              if (defaults[j].first == attribute.fullName)
                 {
-                  std::string env = std::string (envVar);
-                  std::string::size_type cur = 0;
-                  std::string::size_type next = 0;
-                  while (next != std::string::npos)
+                  if (DoSet (info.accessor, info.checker, StringValue (defaults[j].second)))
                     {
-                      next = env.find (";", cur);
-                      std::string tmp = std::string (env, cur, next-cur);
-                      std::string::size_type equal = tmp.find ("=");
-                      if (equal != std::string::npos)
-                        {
-                          std::string name = tmp.substr (0, equal);
-                          std::string value = tmp.substr (equal+1, tmp.size () - equal - 1);
-                          if (name == tid.GetAttributeFullName (i))
-                            {
-                              if (DoSet (info.accessor, info.checker, StringValue (value)))
-                                {
-                                  NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                                                info.name <<"\" from env var");
-                                  found = true;
-                                  break;
-                                }
-                            }
-                        }
-                      cur = next + 1;
+                      NS_LOG_DEBUG ("construct \""<< attribute.fullName <<"\" from env var");
+                      found = true;
+                      break;
                     }
                 }
-#endif /* HAVE_GETENV */
-            }
-          if (!found)
-            {
-              // No matching attribute value so we try to set the default value.
-              DoSet (info.accessor, info.checker, *info.initialValue);
-              NS_LOG_DEBUG ("construct \""<< tid.GetName ()<<"::"<<
-                            info.name <<"\" from initial value.");
             }
         }
-      tid = tid.GetParent ();
-    } while (tid != ObjectBase::GetTypeId ());
+      if (!found)
+        {
+          // No matching attribute value so we try to set the default value.
+          DoSet (info.accessor, info.checker, *info.initialValue);
+          NS_LOG_DEBUG ("construct \""<< attribute.fullName <<"\" from initial value.");
+        }
+    }
   NotifyConstructionCompleted ();
 }
 
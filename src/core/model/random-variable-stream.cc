@@ -35,6 +35,7 @@
 #include "rng-seed-manager.h"
 #include <cmath>
 #include <iostream>
+#include <set>
 
 /**
  * \file
@@ -48,6 +49,26 @@ NS_LOG_COMPONENT_DEFINE ("RandomVariableStream");
 
 NS_OBJECT_ENSURE_REGISTERED (RandomVariableStream);
 
+namespace {
+
+/**
+ * \ingroup randomvariable
+ * Get the set of the existing RandomVariableStream objects.
+ *
+ * The set is never deleted, so that the random variables destroyed
+ * by static destructors can still remove themselves.
+ *
+ * \returns The set.
+ */
+std::set<RandomVariableStream *> &
+GetStreams (void)
+{
+  static std::set<RandomVariableStream *> *streams = new std::set<RandomVariableStream *> ();
+  return *streams;
+}
+
+} // anonymous namespace
+
 TypeId 
 RandomVariableStream::GetTypeId (void)
 {
@@ -75,10 +96,12 @@ RandomVariableStream::RandomVariableStream()
   : m_rng (0)
 {
   NS_LOG_FUNCTION (this);
+  GetStreams ().insert (this);
 }
 RandomVariableStream::~RandomVariableStream()
 {
   NS_LOG_FUNCTION (this);
+  GetStreams ().erase (this);
   delete m_rng;
 }
 
@@ -107,20 +130,18 @@ RandomVariableStream::SetStream (int64_t stream)
       // number assignment.
       uint64_t nextStream = RngSeedManager::GetNextStreamIndex ();
       NS_ASSERT(nextStream <= ((1ULL)<<63));
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             nextStream,
-                             RngSeedManager::GetRun ());
+      m_index = nextStream;
     }
   else
     {
       // The last 2^63 streams are reserved for deterministic stream
       // number assignment.
       uint64_t base = ((1ULL)<<63);
-      uint64_t target = base + stream;
-      m_rng = new RngStream (RngSeedManager::GetSeed (),
-                             target,
-                             RngSeedManager::GetRun ());
+      m_index = base + stream;
     }
+  m_rng = new RngStream (RngSeedManager::GetSeed (),
+                         m_index,
+                         RngSeedManager::GetRun ());
   m_stream = stream;
 }
 int64_t
@@ -130,6 +151,26 @@ RandomVariableStream::GetStream(void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::ReseedAll (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::set<RandomVariableStream *> &streams = GetStreams ();
+  for (std::set<RandomVariableStream *>::iterator i = streams.begin (); i != streams.end (); ++i)
+    {
+      RandomVariableStream *stream = *i;
+      if (stream->m_rng == 0)
+        {
+          // not constructed yet: SetStream will use the new run number.
+          continue;
+        }
+      delete stream->m_rng;
+      stream->m_rng = new RngStream (RngSeedManager::GetSeed (),
+                                     stream->m_index,
+                                     RngSeedManager::GetRun ());
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek(void) const
 {
@@ -125,6 +125,19 @@ public:
    */
   int64_t GetStream(void) const;
 
+  /**
+   * \brief Re-create the RNG streams of all the existing random
+   * variables from the current seed and run number, keeping their
+   * stream numbers.
+   *
+   * A process which changes the run number after creating its random
+   * variables, for instance a replication forked by
+   * ReplicationRunner, calls this method so that its random variables
+   * draw the same values as in a program started with that run
+   * number.
+   */
+  static void ReseedAll (void);
+
   /**
    * \brief Specify whether antithetic values should be generated.
    * \param [in] isAntithetic If \c true antithetic value will be generated.
@@ -186,6 +199,9 @@ private:
   /** The stream number for this RNG stream. */
   int64_t m_stream;
 
+  /** The index of the underlying RNG stream. */
+  uint64_t m_index;
+
 };  // class RandomVariableStream
 
   
@@ -69,6 +69,12 @@ RealtimeSimulatorImpl::GetTypeId (void)
                    TimeValue (Seconds (0.1)),
                    MakeTimeAccessor (&RealtimeSimulatorImpl::m_hardLimit),
                    MakeTimeChecker ())
+    .AddAttribute ("SkipIdle",
+                   "Skip the real time until the next event, instead of waiting for it, "
+                   "while no external source of events is active (hybrid mode).",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RealtimeSimulatorImpl::m_skipIdle),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -90,6 +96,8 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
+  m_externalSources = 0;
+  m_skippedTs = 0;
 
   m_main = SystemThread::Self();
 
@@ -249,6 +257,19 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
             tsDelay = tsNext - tsNow;
           }
 
+        //
+        // In the hybrid mode, if no external source is active, nothing can
+        // be scheduled before the next event: rather than waiting for it, we
+        // move the real time of the synchronizer forward to its timestamp.
+        //
+        if (m_skipIdle && m_externalSources == 0 && tsDelay > 0)
+          {
+            m_synchronizer->Skip (tsDelay);
+            m_skippedTs += tsDelay;
+            tsNow = tsNext;
+            tsDelay = 0;
+          }
+
         //
         // We've figured out how long we need to delay in order to pace the 
         // simulation time with the real time.  We're going to sleep, but need
@@ -841,6 +862,51 @@ RealtimeSimulatorImpl::SetHardLimit (Time limit)
   m_hardLimit = limit;
 }
 
+void
+RealtimeSimulatorImpl::SetSkipIdle (bool skipIdle)
+{
+  NS_LOG_FUNCTION (this << skipIdle);
+  m_skipIdle = skipIdle;
+}
+
+bool
+RealtimeSimulatorImpl::GetSkipIdle (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_skipIdle;
+}
+
+void
+RealtimeSimulatorImpl::AddExternalSource (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  m_externalSources++;
+}
+
+void
+RealtimeSimulatorImpl::RemoveExternalSource (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  NS_ASSERT_MSG (m_externalSources > 0,
+                 "RealtimeSimulatorImpl::RemoveExternalSource(): no active external source");
+  m_externalSources--;
+  // the simulator may now skip the wait for the next event
+  if (m_synchronizer != 0)
+    {
+      m_synchronizer->Signal ();
+    }
+}
+
+Time
+RealtimeSimulatorImpl::GetSkippedTime (void) const
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  return TimeStep (m_skippedTs);
+}
+
 Time
 RealtimeSimulatorImpl::GetHardLimit (void) const
 {
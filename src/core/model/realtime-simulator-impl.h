@@ -154,6 +154,46 @@ public:
    */
   Time GetHardLimit (void) const;
 
+  /**
+   * Enable or disable the hybrid mode.
+   *
+   * In the hybrid mode, the simulator skips the real time until the
+   * next event, instead of waiting for it, as long as no external
+   * source is active: nothing can then be scheduled before that
+   * event.  While an external source is active, the simulator keeps
+   * to real time, as usual.
+   *
+   * \param [in] skipIdle \c true to enable the hybrid mode.
+   * \see AddExternalSource
+   */
+  void SetSkipIdle (bool skipIdle);
+  /**
+   * Is the hybrid mode enabled?
+   * \returns \c true if the idle real time is skipped.
+   */
+  bool GetSkipIdle (void) const;
+
+  /**
+   * Declare an active external source of events, such as the reader
+   * thread of an FdNetDevice or of a TapBridge, which may schedule
+   * events from another thread at any time.
+   *
+   * FdReader declares its reader thread automatically.
+   * \see RemoveExternalSource
+   */
+  void AddExternalSource (void);
+  /**
+   * Declare that an external source declared with AddExternalSource
+   * has stopped.
+   */
+  void RemoveExternalSource (void);
+
+  /**
+   * Get the real time skipped in the hybrid mode.
+   * \returns The total real time skipped since the simulator was created.
+   */
+  Time GetSkippedTime (void) const;
+
 private:
   /**
    * Is the simulator running?
@@ -216,6 +256,13 @@ private:
   /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
   Time m_hardLimit;
 
+  /** Skip the idle real time while no external source is active. */
+  bool m_skipIdle;
+  /** Number of active external sources of events. */
+  uint32_t m_externalSources;
+  /** Total real time skipped, in Time resolution units. */
+  uint64_t m_skippedTs;
+
   /** Main SystemThread. */
   SystemThread::ThreadId m_main;
 };
@@ -19,6 +19,7 @@
  */
 
 #include "scheduler.h"
+#include "event-impl.h"
 #include "assert.h"
 #include "log.h"
 
@@ -49,4 +50,34 @@ Scheduler::GetTypeId (void)
   return tid;
 }
 
+void
+Scheduler::InsertBatch (const std::vector<Event> &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  for (std::vector<Event>::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      Insert (*i);
+    }
+}
+
+void
+Scheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Event> live;
+  while (!IsEmpty ())
+    {
+      Event ev = RemoveNext ();
+      if (ev.impl->IsCancelled ())
+        {
+          cancelled.push_back (ev);
+        }
+      else
+        {
+          live.push_back (ev);
+        }
+    }
+  InsertBatch (live);
+}
+
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "object.h"
 
 /**
@@ -104,6 +105,27 @@ public:
    * \param [in] ev Event to store in the event list
    */
   virtual void Insert (const Event &ev) = 0;
+  /**
+   * Insert a set of new Events in the schedule.
+   *
+   * The default implementation calls Insert() for each event;
+   * subclasses override it when they can merge the whole set in
+   * a single pass.
+   *
+   * \param [in] events The events to store in the event list.
+   */
+  virtual void InsertBatch (const std::vector<Event> &events);
+  /**
+   * Remove all the cancelled events from the event list.
+   *
+   * The default implementation removes all the events and inserts
+   * back the live ones; subclasses override it with a single linear
+   * pass over their storage.  As with Remove(), the caller must
+   * Unref the removed events.
+   *
+   * \param [out] cancelled The removed events are appended to this vector.
+   */
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
   /**
    * Test if the schedule is empty.
    *
@@ -18,6 +18,7 @@
  */
 
 #include "simulator-impl.h"
+#include "event-batch.h"
 #include "log.h"
 
 /**
@@ -42,4 +43,15 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+void
+SimulatorImpl::ScheduleBatch (const EventBatch &batch)
+{
+  NS_LOG_FUNCTION (this << batch.GetN ());
+  for (uint32_t i = 0; i < batch.GetN (); i++)
+    {
+      const EventBatch::Entry &entry = batch.Get (i);
+      ScheduleWithContext (entry.context, entry.delay, entry.event);
+    }
+}
+
 } // namespace ns3
@@ -37,6 +37,7 @@
 namespace ns3 {
 
 class Scheduler;
+class EventBatch;
 
 /**
  * \ingroup simulator
@@ -67,6 +68,13 @@ public:
   virtual EventId Schedule (Time const &delay, EventImpl *event) = 0;
   /** \copydoc Simulator::ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
   virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event) = 0;
+  /**
+   * \copydoc Simulator::ScheduleBatch
+   *
+   * The default implementation calls ScheduleWithContext() for each
+   * event of the batch.
+   */
+  virtual void ScheduleBatch (const EventBatch &batch);
   /** \copydoc Simulator::ScheduleNow(const Ptr<EventImpl>&) */
   virtual EventId ScheduleNow (EventImpl *event) = 0;
   /** \copydoc Simulator::ScheduleDestroy(const Ptr<EventImpl>&) */
@@ -23,6 +23,7 @@
 #include "scheduler.h"
 #include "map-scheduler.h"
 #include "event-impl.h"
+#include "event-batch.h"
 
 #include "ptr.h"
 #include "string.h"
@@ -251,6 +252,16 @@ Simulator::ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *
 {
   return GetImpl ()->ScheduleWithContext (context, delay, impl);
 }
+void
+Simulator::ScheduleBatch (EventBatch &batch)
+{
+  if (batch.IsEmpty ())
+    {
+      return;
+    }
+  GetImpl ()->ScheduleBatch (batch);
+  batch.Forget ();
+}
 EventId
 Simulator::ScheduleDestroy (const Ptr<EventImpl> &ev)
 {
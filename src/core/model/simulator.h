@@ -41,6 +41,7 @@ namespace ns3 {
 
 class SimulatorImpl;
 class Scheduler;
+class EventBatch;
 
 /**
  * @ingroup core
@@ -1135,6 +1136,19 @@ public:
    */
   static void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
 
+  /**
+   * Schedule all the events of a batch (each in its own context).
+   *
+   * This is equivalent to calling ScheduleWithContext() for each
+   * event of the batch, in order, but lets the simulator insert them
+   * in a single pass.  The simulator takes ownership of the events
+   * and the batch is left empty.
+   * This method is thread-safe: it can be called from any thread.
+   *
+   * @param [in,out] batch The events to schedule.
+   */
+  static void ScheduleBatch (EventBatch &batch);
+
   /**
    * Schedule an event to run at the end of the simulation, after
    * the Stop() time or condition has been reached.
@@ -96,6 +96,20 @@ Synchronizer::GetDrift (uint64_t ts)
     }
 }
 
+void
+Synchronizer::Skip (uint64_t ts)
+{
+  NS_LOG_FUNCTION (this << ts);
+  DoSkip (TimeStepToNanosecond (ts));
+}
+
+void
+Synchronizer::DoSkip (uint64_t ns)
+{
+  NS_LOG_FUNCTION (this << ns);
+  m_realtimeOriginNano -= ns;
+}
+
 bool
 Synchronizer::Synchronize (uint64_t tsCurrent, uint64_t tsDelay)
 {
@@ -123,6 +123,19 @@ public:
    */
   int64_t GetDrift (uint64_t ts);
 
+  /**
+   * @brief Move the synchronizer real time forward, without waiting.
+   *
+   * The simulator calls this method to skip the real time during which
+   * it knows that nothing can happen.  Subclasses may override the
+   * corresponding DoSkip virtual method.
+   *
+   * @param [in] ts The amount of real time to skip (in Time resolution
+   *     units).
+   * @see DoSkip
+   */
+  void Skip (uint64_t ts);
+
   /**
    * @brief Wait until the real time is in sync with the specified simulation
    * time or until the synchronizer is Sigalled.
@@ -309,6 +322,17 @@ protected:
    * @returns The elapsed real time, in ns.
    */
   virtual uint64_t DoEventEnd (void) = 0;
+  /**
+   * @brief Move the synchronizer real time forward, without waiting.
+   *
+   * The default implementation moves m_realtimeOriginNano backward,
+   * which suits the synchronizers that normalize their real time
+   * against it.
+   *
+   * @param [in] ns The amount of real time to skip, in ns.
+   * @see Skip
+   */
+  virtual void DoSkip (uint64_t ns);
 
   /** The real time, in ns, when SetOrigin was called. */
   uint64_t m_realtimeOriginNano;
@@ -27,6 +27,7 @@
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 /**
  * \file
@@ -50,8 +51,10 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * \ingroup object
  * \brief TypeId information manager
  *
- * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * Information records are stored in a vector.  Hash lookup is
+ * performed by a map to the vector index, and name lookup by the hash
+ * of the name.  The attribute tables of the types are computed on
+ * demand, and kept until the registry changes.
  *
  * \internal
  * <b>Hash Chaining</b>
@@ -78,6 +81,7 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -225,6 +229,12 @@ public:
    * \returns The information associated to attribute whose index is \p i.
    */
   struct TypeId::AttributeInformation GetAttribute(uint16_t uid, uint32_t i) const;
+  /**
+   * Get the Attributes of a type and of all its parents.
+   * \param [in] uid The id.
+   * \returns The table of the Attributes.
+   */
+  Ptr<TypeId::AttributeTable> GetAttributeTable (uint16_t uid);
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -283,7 +293,7 @@ private:
    * \param [in] name The type id name.
    * \returns The hashed value of \p name.
    */
-  static TypeId::hash_t Hasher (const std::string name);
+  static TypeId::hash_t Hasher (const std::string &name);
 
   /** The information record about a single type id. */
   struct IidInformation {
@@ -307,6 +317,10 @@ private:
     std::vector<struct TypeId::AttributeInformation> attributes;
     /** The container of TraceSources. */
     std::vector<struct TypeId::TraceSourceInformation> traceSources;
+    /** The table of the Attributes of this type and of its parents. */
+    Ptr<TypeId::AttributeTable> attributeTable;
+    /** The generation of the registry when attributeTable was computed. */
+    uint32_t attributeTableGeneration;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
@@ -321,16 +335,17 @@ private:
   /** The container of all type id records. */
   std::vector<struct IidInformation> m_information;
 
-  /** Type of the by-name index. */
-  typedef std::map<std::string, uint16_t> namemap_t;
-  /** The by-name index. */
-  namemap_t m_namemap;
-
   /** Type of the by-hash index. */
   typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /**
+   * The generation of the registry, incremented by each change which
+   * invalidates the attribute tables.
+   */
+  uint32_t m_generation;
+
 
   enum {
     /**
@@ -344,9 +359,15 @@ private:
 };
 
 
+IidManager::IidManager ()
+  : m_generation (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 //static
 TypeId::hash_t
-IidManager::Hasher (const std::string name)
+IidManager::Hasher (const std::string &name)
 {
   static ns3::Hasher hasher ( Create<Hash::Function::Murmur3> () );
   return hasher.clear ().GetHash32 (name);
@@ -357,7 +378,7 @@ IidManager::AllocateUid (std::string name)
 {
   NS_LOG_FUNCTION (this << name);
   // Type names are definitive: equal names are equal types
-  NS_ASSERT_MSG (m_namemap.count (name) == 0,
+  NS_ASSERT_MSG (GetUid (name) == 0,
                  "Trying to allocate twice the same uid: " << name);
   
   TypeId::hash_t hash = Hasher (name) & (~HashChainFlag);
@@ -413,12 +434,11 @@ IidManager::AllocateUid (std::string name)
   information.size = (std::size_t)(-1);
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.attributeTableGeneration = 0;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
 
-  // Add to both maps:
-  m_namemap.insert (std::make_pair (name, uid));
   m_hashmap.insert (std::make_pair (hash, uid));
   return uid;
 }
@@ -438,6 +458,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -478,15 +499,19 @@ uint16_t
 IidManager::GetUid (std::string name) const
 {
   NS_LOG_FUNCTION (this << name);
-  namemap_t::const_iterator it = m_namemap.find (name);
-  if (it != m_namemap.end ())
+  // the name is that of the type of its hash, or of the chained one
+  TypeId::hash_t hash = Hasher (name) & (~HashChainFlag);
+  uint16_t uid = GetUid (hash);
+  if (uid != 0 && LookupInformation (uid)->name == name)
     {
-      return it->second;
+      return uid;
     }
-  else
+  uid = GetUid (hash | HashChainFlag);
+  if (uid != 0 && LookupInformation (uid)->name == name)
     {
-      return 0;
+      return uid;
     }
+  return 0;
 }
 uint16_t 
 IidManager::GetUid (TypeId::hash_t hash) const
@@ -623,6 +648,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.accessor = accessor;
   info.checker = checker;
   information->attributes.push_back (info);
+  m_generation++;
 }
 void 
 IidManager::SetAttributeInitialValue(uint16_t uid,
@@ -633,6 +659,7 @@ IidManager::SetAttributeInitialValue(uint16_t uid,
   struct IidInformation *information = LookupInformation (uid);
   NS_ASSERT (i < information->attributes.size ());
   information->attributes[i].initialValue = initialValue;
+  m_generation++;
 }
 
 
@@ -652,6 +679,46 @@ IidManager::GetAttribute(uint16_t uid, uint32_t i) const
   NS_ASSERT (i < information->attributes.size ());
   return information->attributes[i];
 }
+Ptr<TypeId::AttributeTable>
+IidManager::GetAttributeTable (uint16_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->attributeTable != 0
+      && information->attributeTableGeneration == m_generation)
+    {
+      return information->attributeTable;
+    }
+  Ptr<TypeId::AttributeTable> table = Create<TypeId::AttributeTable> ();
+  uint16_t cur = uid;
+  while (true)
+    {
+      struct IidInformation *curInformation = LookupInformation (cur);
+      for (uint32_t i = 0; i < curInformation->attributes.size (); i++)
+        {
+          struct TypeId::AttributeTable::Attribute attribute;
+          attribute.info = curInformation->attributes[i];
+          attribute.fullName = curInformation->name + "::" + attribute.info.name;
+          attribute.uid = cur;
+          attribute.index = i;
+          uint32_t index = table->attributes.size ();
+          table->names.push_back (std::make_pair (Hasher (attribute.info.name), index));
+          table->checkers.push_back (std::make_pair (PeekPointer (attribute.info.checker), index));
+          table->attributes.push_back (attribute);
+        }
+      if (curInformation->parent == 0 || curInformation->parent == cur)
+        {
+          // top of inheritance tree
+          break;
+        }
+      cur = curInformation->parent;
+    }
+  std::sort (table->names.begin (), table->names.end ());
+  std::sort (table->checkers.begin (), table->checkers.end ());
+  information->attributeTable = table;
+  information->attributeTableGeneration = m_generation;
+  return table;
+}
 
 bool
 IidManager::HasTraceSource (uint16_t uid,
@@ -729,6 +796,43 @@ IidManager::MustHideFromDocumentation (uint16_t uid) const
 
 namespace ns3 {
 
+/*********************************************************************
+ *         The TypeId::AttributeTable class
+ *********************************************************************/
+
+const uint32_t TypeId::AttributeTable::NOT_FOUND;
+
+uint32_t
+TypeId::AttributeTable::Find (const std::string &name) const
+{
+  NS_LOG_FUNCTION (this << name);
+  hash_t hash = IidManager::Hasher (name);
+  std::vector<std::pair<hash_t, uint32_t> >::const_iterator i =
+    std::lower_bound (names.begin (), names.end (), std::make_pair (hash, uint32_t (0)));
+  for ( ; i != names.end () && i->first == hash; ++i)
+    {
+      if (attributes[i->second].info.name == name)
+        {
+          return i->second;
+        }
+    }
+  return NOT_FOUND;
+}
+
+uint32_t
+TypeId::AttributeTable::Find (Ptr<const AttributeChecker> checker) const
+{
+  NS_LOG_FUNCTION (this << checker);
+  std::pair<const AttributeChecker *, uint32_t> key (PeekPointer (checker), 0);
+  std::vector<std::pair<const AttributeChecker *, uint32_t> >::const_iterator i =
+    std::lower_bound (checkers.begin (), checkers.end (), key);
+  if (i != checkers.end () && i->first == key.first)
+    {
+      return i->second;
+    }
+  return NOT_FOUND;
+}
+
 /*********************************************************************
  *         The TypeId class
  *********************************************************************/
@@ -804,22 +908,14 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-          if (tmp.name == name)
-            {
-              *info = tmp;
-              return true;
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  Ptr<const AttributeTable> table = GetAttributeTable ();
+  uint32_t i = table->Find (name);
+  if (i == AttributeTable::NOT_FOUND)
+    {
+      return false;
+    }
+  *info = table->attributes[i].info;
+  return true;
 }
 
 TypeId 
@@ -984,6 +1080,12 @@ TypeId::GetAttributeFullName (uint32_t i) const
   struct TypeId::AttributeInformation info = GetAttribute(i);
   return GetName () + "::" + info.name;
 }
+Ptr<const TypeId::AttributeTable>
+TypeId::GetAttributeTable (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return IidManager::Get ()->GetAttributeTable (m_tid);
+}
 
 uint32_t 
 TypeId::GetTraceSourceN (void) const
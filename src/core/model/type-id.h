@@ -27,7 +27,9 @@
 #include "callback.h"
 #include "deprecated.h"
 #include "hash.h"
+#include "simple-ref-count.h"
 #include <string>
+#include <vector>
 #include <stdint.h>
 
 /**
@@ -97,6 +99,59 @@ public:
   /** Type of hash values. */
   typedef uint32_t hash_t;
 
+  /**
+   * \brief The Attributes of a type and of all its parents, indexed for
+   * the construction of objects.
+   *
+   * The attributes are ordered from those of the type up to those of
+   * its oldest parent, each in registration order, which is the order
+   * in which ObjectBase::ConstructSelf sets them.  They are indexed by
+   * the hash of their name, and by their checker.
+   *
+   * The table of a type is computed on the first request, and then
+   * shared, until an attribute, a parent or an initial value of a type
+   * changes.
+   */
+  struct AttributeTable : public SimpleRefCount<AttributeTable>
+  {
+    /** The index of the attributes which are not found. */
+    static const uint32_t NOT_FOUND = 0xffffffff;
+
+    /**
+     * Find an attribute by name.
+     *
+     * \param [in] name The name of the attribute.
+     * \returns The index of the attribute, or NOT_FOUND.
+     */
+    uint32_t Find (const std::string &name) const;
+    /**
+     * Find an attribute by checker.
+     *
+     * \param [in] checker The checker of the attribute.
+     * \returns The index of the attribute, or NOT_FOUND.
+     */
+    uint32_t Find (Ptr<const AttributeChecker> checker) const;
+
+    /** An attribute of the table. */
+    struct Attribute
+    {
+      /** The attribute. */
+      struct AttributeInformation info;
+      /** The full name of the attribute: "ns3::Type::Attribute". */
+      std::string fullName;
+      /** The uid of the TypeId which registered the attribute. */
+      uint16_t uid;
+      /** The index of the attribute in that TypeId. */
+      uint32_t index;
+    };
+    /** The attributes. */
+    std::vector<struct Attribute> attributes;
+    /** The hashes of the names, with the indexes of the attributes, sorted. */
+    std::vector<std::pair<hash_t, uint32_t> > names;
+    /** The checkers, with the indexes of the attributes, sorted. */
+    std::vector<std::pair<const AttributeChecker *, uint32_t> > checkers;
+  };
+
   /**
    * Get a TypeId by name.
    *
@@ -247,6 +302,12 @@ public:
    * \returns The full name associated to the attribute whose index is \p i.
    */
   std::string GetAttributeFullName (uint32_t i) const;
+  /**
+   * Get the Attributes of this TypeId and of all its parents.
+   *
+   * \returns The table of the Attributes.
+   */
+  Ptr<const AttributeTable> GetAttributeTable (void) const;
 
   /**
    * Get the constructor callback.
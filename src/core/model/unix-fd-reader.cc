@@ -32,6 +32,11 @@
 
 #include "unix-fd-reader.h"
 
+#include "ns3/core-config.h"
+#ifdef HAVE_RT
+#include "realtime-simulator-impl.h"
+#endif
+
 /**
  * \file
  * \ingroup system
@@ -44,7 +49,7 @@ NS_LOG_COMPONENT_DEFINE ("FdReader");
 
 FdReader::FdReader ()
   : m_fd (-1), m_readCallback (0), m_readThread (0), m_stop (false),
-    m_destroyEvent ()
+    m_externalSource (false), m_destroyEvent ()
 {
   NS_LOG_FUNCTION (this);
   m_evpipe[0] = -1;
@@ -106,6 +111,21 @@ void FdReader::Start (int fd, Callback<void, uint8_t *, ssize_t> readCallback)
   NS_LOG_LOGIC ("Spinning up read thread");
 
   m_readThread = Create<SystemThread> (MakeCallback (&FdReader::Run, this));
+
+#ifdef HAVE_RT
+  //
+  // The read thread may schedule events at any time: a realtime simulator
+  // in the hybrid mode must not skip the idle real time while it runs.
+  //
+  Ptr<RealtimeSimulatorImpl> realtime =
+    DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+  if (realtime != 0)
+    {
+      realtime->AddExternalSource ();
+      m_externalSource = true;
+    }
+#endif
+
   m_readThread->Start ();
 }
 
@@ -151,6 +171,19 @@ void FdReader::Stop (void)
       m_evpipe[0] = -1;
     }
 
+#ifdef HAVE_RT
+  if (m_externalSource)
+    {
+      Ptr<RealtimeSimulatorImpl> realtime =
+        DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+      if (realtime != 0)
+        {
+          realtime->RemoveExternalSource ();
+        }
+      m_externalSource = false;
+    }
+#endif
+
   // reset everything else
   m_fd = -1;
   m_readCallback.Nullify ();
@@ -127,6 +127,11 @@ private:
   int m_evpipe[2];
   /** Signal the read thread to stop. */
   bool m_stop;
+  /**
+   * The read thread is declared as an external source of events to
+   * the RealtimeSimulatorImpl.
+   */
+  bool m_externalSource;
   
   /**
    * The event scheduled for destroy time which will invoke DestroyEvent
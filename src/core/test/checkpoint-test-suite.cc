@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/checkpoint.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+#include <unistd.h>
+
+using namespace ns3;
+
+class CheckpointTestCase : public TestCase
+{
+public:
+  CheckpointTestCase ();
+  virtual void DoRun (void);
+  void Tick (void);
+  void EndOfWarmUp (void);
+
+  Checkpoint m_checkpoint;
+  uint32_t m_variant;
+  uint32_t m_increment;
+  uint32_t m_sum;
+  uint32_t m_failures;
+  uint32_t m_firstDraw;
+  Ptr<UniformRandomVariable> m_random;
+};
+
+CheckpointTestCase::CheckpointTestCase ()
+  : TestCase ("Check that variants resume from a snapshot")
+{
+}
+
+void
+CheckpointTestCase::Tick (void)
+{
+  m_sum += m_increment;
+  if (Simulator::Now () < Seconds (10))
+    {
+      Simulator::Schedule (Seconds (1), &CheckpointTestCase::Tick, this);
+    }
+}
+
+void
+CheckpointTestCase::EndOfWarmUp (void)
+{
+  m_variant = m_checkpoint.Take ();
+  if (m_variant == Checkpoint::ORIGINAL)
+    {
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          m_checkpoint.Resume (i);
+        }
+      m_failures = m_checkpoint.Wait ();
+      m_checkpoint.Release ();
+      Simulator::Stop ();
+      return;
+    }
+  m_increment = m_variant + 1;
+}
+
+void
+CheckpointTestCase::DoRun (void)
+{
+  m_variant = Checkpoint::ORIGINAL;
+  m_increment = 1;
+  m_sum = 0;
+  m_failures = 0;
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  // all the variants should draw the same number after the snapshot
+  Ptr<UniformRandomVariable> probe = CreateObject<UniformRandomVariable> ();
+  probe->SetStream (1);
+  probe->GetInteger (0, 1000000);
+  uint32_t expectedDraw = probe->GetInteger (0, 1000000);
+  m_random->GetInteger (0, 1000000);
+
+  Simulator::Schedule (Seconds (0), &CheckpointTestCase::Tick, this);
+  Simulator::Schedule (Seconds (5.5), &CheckpointTestCase::EndOfWarmUp, this);
+  Simulator::Run ();
+
+  if (m_variant != Checkpoint::ORIGINAL)
+    {
+      // 6 ticks before the snapshot, 5 after it; variant 2 reports
+      // a failure on purpose.
+      bool ok = m_sum == 6 + 5 * m_increment
+        && Simulator::Now () == Seconds (10)
+        && m_random->GetInteger (0, 1000000) == expectedDraw
+        && m_variant != 2;
+      _exit (ok ? 0 : 1);
+    }
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_sum, 6, "The original should stop at the snapshot");
+  NS_TEST_ASSERT_MSG_EQ (m_failures, 1, "Only one variant should fail");
+  NS_TEST_ASSERT_MSG_EQ (m_checkpoint.IsTaken (), false, "The snapshot should be released");
+}
+
+static class CheckpointTestSuite : public TestSuite
+{
+public:
+  CheckpointTestSuite ()
+    : TestSuite ("checkpoint", UNIT)
+  {
+    AddTestCase (new CheckpointTestCase (), TestCase::QUICK);
+  }
+} g_checkpointTestSuite;
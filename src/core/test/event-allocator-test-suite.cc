@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/event-allocator.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include <set>
+#include <string.h>
+
+using namespace ns3;
+
+class EventAllocatorBlocksTestCase : public TestCase
+{
+public:
+  EventAllocatorBlocksTestCase ();
+  virtual void DoRun (void);
+};
+
+EventAllocatorBlocksTestCase::EventAllocatorBlocksTestCase ()
+  : TestCase ("Check that the allocator returns distinct, aligned and recycled blocks")
+{
+}
+
+void
+EventAllocatorBlocksTestCase::DoRun (void)
+{
+  const std::size_t sizes[] = { 1, 16, 17, 48, 100, 256, 257, 4000 };
+  const uint32_t n = sizeof (sizes) / sizeof (sizes[0]);
+  void *blocks[n][64];
+  std::set<void *> distinct;
+
+  EventAllocator::Stats before = EventAllocator::GetStats ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < 64; j++)
+        {
+          blocks[i][j] = EventAllocator::Allocate (sizes[i]);
+          NS_TEST_ASSERT_MSG_EQ (reinterpret_cast<uintptr_t> (blocks[i][j]) % 16, 0, "Block is not aligned");
+          memset (blocks[i][j], i, sizes[i]);
+          distinct.insert (blocks[i][j]);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (distinct.size (), n * 64, "Blocks are not distinct");
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (uint32_t j = 0; j < 64; j++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (static_cast<unsigned char *> (blocks[i][j])[sizes[i] - 1], i, "Block was overwritten");
+          EventAllocator::Deallocate (blocks[i][j], sizes[i]);
+        }
+    }
+  EventAllocator::Stats middle = EventAllocator::GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (middle.allocations - before.allocations, n * 64, "Wrong number of allocations");
+  NS_TEST_ASSERT_MSG_EQ (middle.deallocations - before.deallocations, n * 64, "Wrong number of deallocations");
+  NS_TEST_ASSERT_MSG_EQ (middle.oversized - before.oversized, 2 * 64, "Wrong number of oversized allocations");
+
+  // the blocks released last are allocated first
+  void *block = EventAllocator::Allocate (100);
+  NS_TEST_ASSERT_MSG_EQ (block, blocks[4][63], "Block was not recycled");
+  EventAllocator::Deallocate (block, 100);
+  EventAllocator::Stats after = EventAllocator::GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (after.recycled - middle.recycled, 1, "Allocation was not counted as recycled");
+  NS_TEST_ASSERT_MSG_EQ (after.chunks, middle.chunks, "Recycling allocated a chunk");
+}
+
+class EventAllocatorSimulatorTestCase : public TestCase
+{
+public:
+  EventAllocatorSimulatorTestCase ();
+  virtual void DoRun (void);
+  void Reschedule (uint32_t remaining);
+};
+
+EventAllocatorSimulatorTestCase::EventAllocatorSimulatorTestCase ()
+  : TestCase ("Check that scheduled events are allocated by the allocator")
+{
+}
+
+void
+EventAllocatorSimulatorTestCase::Reschedule (uint32_t remaining)
+{
+  if (remaining > 0)
+    {
+      Simulator::Schedule (MicroSeconds (1), &EventAllocatorSimulatorTestCase::Reschedule, this, remaining - 1);
+    }
+}
+
+void
+EventAllocatorSimulatorTestCase::DoRun (void)
+{
+  // run once so that the allocator holds the blocks needed by the run
+  Simulator::Schedule (MicroSeconds (1), &EventAllocatorSimulatorTestCase::Reschedule, this, 1000);
+  Simulator::Run ();
+  EventAllocator::Stats before = EventAllocator::GetStats ();
+
+  Simulator::Schedule (MicroSeconds (1), &EventAllocatorSimulatorTestCase::Reschedule, this, 1000);
+  Simulator::Run ();
+  EventAllocator::Stats after = EventAllocator::GetStats ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (after.allocations - before.allocations, 1001, "Events were not allocated by the allocator");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (after.deallocations - before.deallocations, 1001, "Events were not released to the allocator");
+  NS_TEST_ASSERT_MSG_EQ (after.chunks, before.chunks, "A steady-state run should not allocate chunks");
+}
+
+static class EventAllocatorTestSuite : public TestSuite
+{
+public:
+  EventAllocatorTestSuite ()
+    : TestSuite ("event-allocator", UNIT)
+  {
+    AddTestCase (new EventAllocatorBlocksTestCase (), TestCase::QUICK);
+    AddTestCase (new EventAllocatorSimulatorTestCase (), TestCase::QUICK);
+  }
+} g_eventAllocatorTestSuite;
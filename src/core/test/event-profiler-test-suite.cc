@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/event-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/object.h"
+#include "ns3/test.h"
+#include <fstream>
+#include <string>
+
+using namespace ns3;
+
+namespace ns3 {
+
+class ProfiledObject : public Object
+{
+public:
+  ProfiledObject ()
+    : m_received (0)
+  {
+  }
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::ProfiledObject")
+      .SetParent<Object> ()
+      .SetGroupName ("ProfiledGroup")
+    ;
+    return tid;
+  }
+  void Receive (int value)
+  {
+    m_received += value;
+  }
+  int m_received;
+};
+
+} // namespace ns3
+
+static void
+ProfiledFunction (int value)
+{
+}
+
+class EventProfilerNamesTestCase : public TestCase
+{
+public:
+  EventProfilerNamesTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerNamesTestCase::EventProfilerNamesTestCase ()
+  : TestCase ("Check the callback and module names of events")
+{
+}
+
+void
+EventProfilerNamesTestCase::DoRun (void)
+{
+  Ptr<ProfiledObject> object = CreateObject<ProfiledObject> ();
+  EventImpl *event = MakeEvent (&ProfiledObject::Receive, object, 1);
+  std::string name = EventProfiler::GetCallbackName (event);
+  event->Unref ();
+  NS_TEST_ASSERT_MSG_EQ (name, "void (ns3::ProfiledObject::*)(int)", "Wrong member callback name");
+
+  event = MakeEvent (&ProfiledFunction, 1);
+  name = EventProfiler::GetCallbackName (event);
+  event->Unref ();
+  NS_TEST_ASSERT_MSG_EQ (name, "void (*)(int)", "Wrong function callback name");
+
+  NS_TEST_ASSERT_MSG_EQ (EventProfiler::GetModuleName ("void (ns3::ProfiledObject::*)(int)"), "ProfiledGroup", "Wrong module");
+  NS_TEST_ASSERT_MSG_EQ (EventProfiler::GetModuleName ("void (*)(int)"), "unknown", "Wrong module");
+}
+
+class EventProfilerReportTestCase : public TestCase
+{
+public:
+  EventProfilerReportTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerReportTestCase::EventProfilerReportTestCase ()
+  : TestCase ("Check the profile report of DefaultSimulatorImpl")
+{
+}
+
+void
+EventProfilerReportTestCase::DoRun (void)
+{
+  std::string file = CreateTempDirFilename ("event-profile.csv");
+  // the attribute applies to the simulator created after it is set
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFile", StringValue (file));
+  Ptr<ProfiledObject> object = CreateObject<ProfiledObject> ();
+  object->m_received = 0;
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::ScheduleWithContext (i % 2, MicroSeconds (i), &ProfiledObject::Receive, object, 1);
+    }
+  Simulator::Schedule (MicroSeconds (20), &ProfiledFunction, 2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::ProfileFile", StringValue (""));
+  NS_TEST_ASSERT_MSG_EQ (object->m_received, 10, "Events did not run");
+
+  std::ifstream is (file.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (is.is_open (), true, "Report was not written");
+  std::string line;
+  std::getline (is, line);
+  NS_TEST_ASSERT_MSG_EQ (line, "category,name,events,seconds,percent", "Wrong header");
+  uint32_t modules = 0;
+  uint32_t nodes = 0;
+  uint32_t callbacks = 0;
+  bool receive = false;
+  bool group = false;
+  while (std::getline (is, line))
+    {
+      std::string category = line.substr (0, line.find (','));
+      modules += category == "module";
+      nodes += category == "node";
+      callbacks += category == "callback";
+      if (line.find ("callback,\"void (ns3::ProfiledObject::*)(int)\",10,") == 0)
+        {
+          receive = true;
+        }
+      if (line.find ("module,\"ProfiledGroup\",10,") == 0)
+        {
+          group = true;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (modules, 2, "Expected modules ProfiledGroup and unknown");
+  NS_TEST_ASSERT_MSG_EQ (nodes, 3, "Expected contexts 0, 1 and none");
+  NS_TEST_ASSERT_MSG_EQ (callbacks, 2, "Expected two callbacks");
+  NS_TEST_ASSERT_MSG_EQ (receive, true, "Receive callback not reported");
+  NS_TEST_ASSERT_MSG_EQ (group, true, "ProfiledGroup module not reported");
+}
+
+static class EventProfilerTestSuite : public TestSuite
+{
+public:
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler", UNIT)
+  {
+    AddTestCase (new EventProfilerNamesTestCase (), TestCase::QUICK);
+    AddTestCase (new EventProfilerReportTestCase (), TestCase::QUICK);
+  }
+} g_eventProfilerTestSuite;
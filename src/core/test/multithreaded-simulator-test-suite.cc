@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Events hop along a ring of contexts; every context records the
+ * events it runs.  The records made by the multithreaded simulator
+ * must match the ones made by the default simulator.
+ */
+class MultithreadedSimulatorRingTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorRingTestCase (uint32_t threads, uint32_t partitions);
+
+private:
+  virtual void DoRun (void);
+  /** A record: time in ns and remaining hops. */
+  typedef std::vector<std::pair<int64_t, uint32_t> > Log;
+  void Hop (uint32_t context, uint32_t hops);
+  void Local (uint32_t context, uint32_t hops);
+  void Start (void);
+  std::vector<Log> RunWith (Ptr<SimulatorImpl> impl);
+
+  uint32_t m_threads;
+  uint32_t m_partitions;
+  std::vector<Log> m_logs;
+  std::vector<bool> m_badContext;
+  static const uint32_t N_CONTEXTS = 8;
+};
+
+MultithreadedSimulatorRingTestCase::MultithreadedSimulatorRingTestCase (uint32_t threads, uint32_t partitions)
+  : TestCase ("Check event ordering of MultithreadedSimulatorImpl"),
+    m_threads (threads),
+    m_partitions (partitions)
+{
+}
+
+void
+MultithreadedSimulatorRingTestCase::Hop (uint32_t context, uint32_t hops)
+{
+  if (Simulator::GetContext () != context)
+    {
+      m_badContext[context] = true;
+    }
+  m_logs[context].push_back (std::make_pair (Simulator::Now ().GetNanoSeconds (), hops));
+  if (hops == 0)
+    {
+      return;
+    }
+  uint32_t next = (context + 1) % N_CONTEXTS;
+  Simulator::ScheduleWithContext (next, MilliSeconds (1) + MicroSeconds (37 * (context % 3)),
+                                  &MultithreadedSimulatorRingTestCase::Hop, this, next, hops - 1);
+  Simulator::Schedule (MicroSeconds (250 + hops),
+                       &MultithreadedSimulatorRingTestCase::Local, this, context, hops);
+}
+
+void
+MultithreadedSimulatorRingTestCase::Local (uint32_t context, uint32_t hops)
+{
+  if (Simulator::GetContext () != context)
+    {
+      m_badContext[context] = true;
+    }
+  m_logs[context].push_back (std::make_pair (Simulator::Now ().GetNanoSeconds (), 1000 + hops));
+}
+
+void
+MultithreadedSimulatorRingTestCase::Start (void)
+{
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (3 * i),
+                                      &MultithreadedSimulatorRingTestCase::Hop, this, i, 40);
+    }
+}
+
+std::vector<MultithreadedSimulatorRingTestCase::Log>
+MultithreadedSimulatorRingTestCase::RunWith (Ptr<SimulatorImpl> impl)
+{
+  m_logs.clear ();
+  m_logs.resize (N_CONTEXTS);
+  m_badContext.clear ();
+  m_badContext.resize (N_CONTEXTS, false);
+
+  Simulator::SetImplementation (impl);
+  Start ();
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      // events of a context sharing a timestamp may legitimately run
+      // in a different order.
+      std::sort (m_logs[i].begin (), m_logs[i].end ());
+      NS_TEST_EXPECT_MSG_EQ (m_badContext[i], false, "Wrong context seen by events of context " << i);
+    }
+  return m_logs;
+}
+
+void
+MultithreadedSimulatorRingTestCase::DoRun (void)
+{
+  std::vector<Log> expected = RunWith (CreateObject<DefaultSimulatorImpl> ());
+
+  Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl> ();
+  impl->SetThreadCount (m_threads);
+  impl->SetPartitionCount (m_partitions);
+  impl->SetPartition (0, 0);
+  impl->SetPartition (1, 0);
+  impl->SetLookAhead (MilliSeconds (1));
+  std::vector<Log> logs = RunWith (impl);
+
+  for (uint32_t i = 0; i < N_CONTEXTS; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (logs[i].size (), expected[i].size (), "Wrong number of events in context " << i);
+      for (uint32_t j = 0; j < logs[i].size (); ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ (logs[i][j].first, expected[i][j].first, "Wrong time in context " << i);
+          NS_TEST_EXPECT_MSG_EQ (logs[i][j].second, expected[i][j].second, "Wrong event in context " << i);
+        }
+    }
+  if (m_partitions > 1)
+    {
+      NS_TEST_EXPECT_MSG_GT (impl->GetWindowCount (), 1, "Expected several windows");
+      NS_TEST_EXPECT_MSG_GT (impl->GetRemoteEventCount (), 0, "Expected events across partitions");
+    }
+}
+
+/**
+ * Check Simulator::Stop, Simulator::Now and EventId handling.
+ */
+class MultithreadedSimulatorStopTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorStopTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Tick (uint32_t context);
+  void Cancelled (void);
+
+  std::vector<int64_t> m_last;
+  bool m_cancelledRan;
+};
+
+MultithreadedSimulatorStopTestCase::MultithreadedSimulatorStopTestCase ()
+  : TestCase ("Check stop and cancel with MultithreadedSimulatorImpl")
+{
+}
+
+void
+MultithreadedSimulatorStopTestCase::Tick (uint32_t context)
+{
+  m_last[context] = Simulator::Now ().GetMicroSeconds ();
+  EventId id = Simulator::Schedule (MicroSeconds (5), &MultithreadedSimulatorStopTestCase::Cancelled, this);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsExpired (id), false, "Event should be pending");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetDelayLeft (id), MicroSeconds (5), "Wrong delay left");
+  Simulator::Cancel (id);
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsExpired (id), true, "Cancelled event should be expired");
+  Simulator::ScheduleWithContext ((context + 1) % m_last.size (), MicroSeconds (100),
+                                  &MultithreadedSimulatorStopTestCase::Tick, this, (context + 1) % m_last.size ());
+}
+
+void
+MultithreadedSimulatorStopTestCase::Cancelled (void)
+{
+  m_cancelledRan = true;
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoRun (void)
+{
+  m_last.clear ();
+  m_last.resize (4, -1);
+  m_cancelledRan = false;
+
+  Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl> ();
+  impl->SetThreadCount (2);
+  impl->SetPartitionCount (4);
+  impl->SetLookAhead (MicroSeconds (100));
+  Simulator::SetImplementation (impl);
+
+  Simulator::ScheduleWithContext (0, Seconds (0), &MultithreadedSimulatorStopTestCase::Tick, this, 0);
+  Simulator::Stop (MicroSeconds (1000));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (1000), "Wrong time after stop");
+  NS_TEST_EXPECT_MSG_EQ (m_last[0], 800, "Wrong last event on context 0");
+  NS_TEST_EXPECT_MSG_EQ (m_last[1], 900, "Wrong last event on context 1");
+  NS_TEST_EXPECT_MSG_EQ (m_last[2], 1000, "Wrong last event on context 2");
+  NS_TEST_EXPECT_MSG_EQ (m_last[3], 700, "Wrong last event on context 3");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), false, "Simulation should be resumable");
+
+  Simulator::Stop (MicroSeconds (150));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (1150), "Wrong time after second stop");
+  NS_TEST_EXPECT_MSG_EQ (m_last[3], 1100, "Wrong last event on context 3");
+  NS_TEST_EXPECT_MSG_EQ (m_cancelledRan, false, "Cancelled event was run");
+  Simulator::Destroy ();
+}
+
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorRingTestCase (1, 1), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorRingTestCase (1, 4), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorRingTestCase (2, 4), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorRingTestCase (4, 3), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorStopTestCase (), TestCase::QUICK);
+  }
+} g_multithreadedSimulatorTestSuite;
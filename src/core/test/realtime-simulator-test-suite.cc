@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/realtime-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/boolean.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+class RealtimeSkipIdleTestCase : public TestCase
+{
+public:
+  /**
+   * \param [in] external Declare an active external source.
+   */
+  RealtimeSkipIdleTestCase (bool external);
+  virtual void DoRun (void);
+  void Event (void);
+
+  bool m_external;
+  uint32_t m_events;
+};
+
+RealtimeSkipIdleTestCase::RealtimeSkipIdleTestCase (bool external)
+  : TestCase (external
+              ? "Check that the hybrid mode keeps to real time with an external source"
+              : "Check that the hybrid mode skips the idle real time"),
+    m_external (external)
+{
+}
+
+void
+RealtimeSkipIdleTestCase::Event (void)
+{
+  m_events++;
+}
+
+void
+RealtimeSkipIdleTestCase::DoRun (void)
+{
+  m_events = 0;
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::RealtimeSimulatorImpl"));
+  Config::SetDefault ("ns3::RealtimeSimulatorImpl::SkipIdle", BooleanValue (true));
+
+  Ptr<RealtimeSimulatorImpl> impl = DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_EQ ((impl != 0), true, "Expected a RealtimeSimulatorImpl");
+  NS_TEST_ASSERT_MSG_EQ (impl->GetSkipIdle (), true, "SkipIdle attribute not applied");
+  Time last = m_external ? MilliSeconds (300) : Seconds (100);
+  Time middle = m_external ? MilliSeconds (150) : Seconds (50);
+  if (m_external)
+    {
+      impl->AddExternalSource ();
+    }
+  Simulator::Schedule (Seconds (0), &RealtimeSkipIdleTestCase::Event, this);
+  Simulator::Schedule (middle, &RealtimeSkipIdleTestCase::Event, this);
+  Simulator::Schedule (last, &RealtimeSkipIdleTestCase::Event, this);
+  // with an empty queue, the realtime simulator waits for external events
+  Simulator::Stop (last);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+  if (m_external)
+    {
+      impl->RemoveExternalSource ();
+    }
+  Time skipped = impl->GetSkippedTime ();
+  impl = 0;
+  Simulator::Destroy ();
+  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::RealtimeSimulatorImpl::SkipIdle", BooleanValue (false));
+
+  NS_TEST_ASSERT_MSG_EQ (m_events, 3, "Events did not run");
+  if (m_external)
+    {
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (elapsed, 290, "Should keep to real time");
+      NS_TEST_ASSERT_MSG_EQ (skipped, Seconds (0), "Nothing should be skipped");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_LT (elapsed, 10000, "Should not wait for the events");
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (skipped, Seconds (99), "Idle time should be skipped");
+    }
+}
+
+static class RealtimeSimulatorTestSuite : public TestSuite
+{
+public:
+  RealtimeSimulatorTestSuite ()
+    : TestSuite ("realtime-simulator", UNIT)
+  {
+    AddTestCase (new RealtimeSkipIdleTestCase (false), TestCase::QUICK);
+    AddTestCase (new RealtimeSkipIdleTestCase (true), TestCase::QUICK);
+  }
+} g_realtimeSimulatorTestSuite;
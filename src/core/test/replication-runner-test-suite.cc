@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/replication-runner.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/test.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+class ReplicationRunnerTestCase : public TestCase
+{
+public:
+  ReplicationRunnerTestCase ();
+  virtual void DoRun (void);
+};
+
+ReplicationRunnerTestCase::ReplicationRunnerTestCase ()
+  : TestCase ("Check that the replications are reseeded and merged")
+{
+}
+
+void
+ReplicationRunnerTestCase::DoRun (void)
+{
+  uint64_t run = RngSeedManager::GetRun ();
+  std::string text = CreateTempDirFilename ("replications.txt");
+  std::string xml = CreateTempDirFilename ("replications.xml");
+
+  // the values a program started with each run number would draw
+  std::ostringstream expected;
+  for (uint64_t i = 1; i <= 4; i++)
+    {
+      if (i == 3)
+        {
+          continue;
+        }
+      RngSeedManager::SetRun (i);
+      Ptr<UniformRandomVariable> probe = CreateObject<UniformRandomVariable> ();
+      probe->SetStream (7);
+      expected << i << " " << probe->GetInteger (0, 1000000) << std::endl;
+    }
+  RngSeedManager::SetRun (run);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (7);
+
+  ReplicationRunner runner;
+  runner.SetRuns (1, 4);
+  runner.SetMaxProcesses (2);
+  runner.AddOutput (text, ReplicationRunner::CONCATENATE);
+  runner.AddOutput (xml, ReplicationRunner::XML);
+  if (runner.Fork ())
+    {
+      if (runner.GetRun () == 3)
+        {
+          // fails without writing its outputs
+          runner.Exit (1);
+        }
+      std::ofstream os (runner.GetOutputFilename (text).c_str ());
+      os << runner.GetRun () << " " << random->GetInteger (0, 1000000) << std::endl;
+      os.close ();
+      os.open (runner.GetOutputFilename (xml).c_str ());
+      os << "<?xml version=\"1.0\" ?>" << std::endl
+         << "<Result/>" << std::endl;
+      os.close ();
+      runner.Exit ();
+    }
+  RngSeedManager::SetRun (run);
+
+  NS_TEST_ASSERT_MSG_EQ (runner.GetFailures (), 1, "Only run 3 should fail");
+
+  std::ifstream is (text.c_str ());
+  std::ostringstream merged;
+  merged << is.rdbuf ();
+  NS_TEST_ASSERT_MSG_EQ (merged.str (), expected.str (), "Wrong draws or order");
+
+  is.close ();
+  is.open (xml.c_str ());
+  merged.str ("");
+  merged << is.rdbuf ();
+  NS_TEST_ASSERT_MSG_EQ (merged.str (),
+                         "<?xml version=\"1.0\" ?>\n"
+                         "<Replications>\n"
+                         "<Replication run=\"1\">\n<Result/>\n</Replication>\n"
+                         "<Replication run=\"2\">\n<Result/>\n</Replication>\n"
+                         "<Replication run=\"4\">\n<Result/>\n</Replication>\n"
+                         "</Replications>\n",
+                         "Wrong XML merge");
+  std::ifstream removed (CreateTempDirFilename ("replications.txt.run1").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (removed.is_open (), false, "The files of the workers should be removed");
+}
+
+static class ReplicationRunnerTestSuite : public TestSuite
+{
+public:
+  ReplicationRunnerTestSuite ()
+    : TestSuite ("replication-runner", UNIT)
+  {
+    AddTestCase (new ReplicationRunnerTestCase (), TestCase::QUICK);
+  }
+} g_replicationRunnerTestSuite;
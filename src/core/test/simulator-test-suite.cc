@@ -19,10 +19,19 @@
  */
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/event-batch.h"
+#include "ns3/make-event.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include <map>
+#include <set>
+#include <vector>
 
 using namespace ns3;
 
@@ -168,6 +177,259 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events are dequeued in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  std::set<Scheduler::EventKey> expected;
+  std::vector<Scheduler::Event> pending;
+  uint32_t uid = 0;
+  uint64_t now = 0;
+
+  // a hold model with a bursty increment distribution, interleaved
+  // with the removal of random pending events.  Every 1000 steps, a
+  // burst of events is scheduled in a narrow time range.
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      bool burst = (i % 1000) == 999;
+      uint32_t n = burst ? 2000 : random->GetInteger (0, 2);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          Scheduler::Event ev;
+          ev.impl = 0;
+          if (burst)
+            {
+              ev.key.m_ts = now + 1000000 + random->GetInteger (0, 2000);
+            }
+          else if (random->GetValue () < 0.1)
+            {
+              ev.key.m_ts = now + random->GetInteger (0, 1000000);
+            }
+          else
+            {
+              ev.key.m_ts = now + random->GetInteger (0, 50);
+            }
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          scheduler->Insert (ev);
+          expected.insert (ev.key);
+          pending.push_back (ev);
+        }
+      if (!pending.empty () && random->GetValue () < 0.2)
+        {
+          uint32_t k = random->GetInteger (0, pending.size () - 1);
+          Scheduler::Event ev = pending[k];
+          pending[k] = pending.back ();
+          pending.pop_back ();
+          if (expected.erase (ev.key) == 1)
+            {
+              scheduler->Remove (ev);
+            }
+        }
+      if (!expected.empty ())
+        {
+          Scheduler::Event ev = scheduler->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.begin ()->m_uid, "Wrong event dequeued");
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.begin ()->m_ts, "Wrong event timestamp");
+          expected.erase (expected.begin ());
+          now = ev.key.m_ts;
+        }
+    }
+  while (!expected.empty ())
+    {
+      Scheduler::Event ev = scheduler->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.begin ()->m_uid, "Wrong event dequeued");
+      expected.erase (expected.begin ());
+    }
+  NS_TEST_EXPECT_MSG_EQ (scheduler->IsEmpty (), true, "Scheduler should be empty");
+}
+
+class SimulatorBatchTestCase : public TestCase
+{
+public:
+  SimulatorBatchTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Event (uint32_t index);
+  ObjectFactory m_schedulerFactory;
+  std::vector<uint32_t> m_order;
+};
+
+SimulatorBatchTestCase::SimulatorBatchTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that batches run in the order of sequential scheduling with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SimulatorBatchTestCase::Event (uint32_t index)
+{
+  m_order.push_back (index);
+}
+
+void
+SimulatorBatchTestCase::DoRun (void)
+{
+  Simulator::SetScheduler (m_schedulerFactory);
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  m_order.clear ();
+
+  // the expected order sorts on the timestamp, then on the order of
+  // scheduling: a multimap keeps the insertion order of equal keys
+  std::multimap<int64_t, uint32_t> expected;
+  uint32_t index = 0;
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      // few distinct delays, to have many events with equal timestamps
+      if (random->GetValue () < 0.5)
+        {
+          Time delay = NanoSeconds (random->GetInteger (0, 20));
+          Simulator::Schedule (delay, &SimulatorBatchTestCase::Event, this, index);
+          expected.insert (std::make_pair (delay.GetTimeStep (), index));
+          index++;
+          continue;
+        }
+      EventBatch batch;
+      uint32_t n = i % 20 == 0 ? 500 : random->GetInteger (0, 10);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          Time delay = NanoSeconds (random->GetInteger (0, 20));
+          batch.Add (j, delay, MakeEvent (&SimulatorBatchTestCase::Event, this, index));
+          expected.insert (std::make_pair (delay.GetTimeStep (), index));
+          index++;
+        }
+      Simulator::ScheduleBatch (batch);
+      NS_TEST_ASSERT_MSG_EQ (batch.IsEmpty (), true, "The batch should be emptied");
+    }
+
+  // the events of a batch which is not scheduled never run
+  EventBatch dropped;
+  dropped.Add (0, Seconds (0), MakeEvent (&SimulatorBatchTestCase::Event, this, index));
+  dropped.Clear ();
+  dropped.Add (0, Seconds (0), MakeEvent (&SimulatorBatchTestCase::Event, this, index));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), expected.size (), "Wrong number of events");
+  std::multimap<int64_t, uint32_t>::const_iterator k = expected.begin ();
+  for (uint32_t i = 0; i < m_order.size (); i++, k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_order[i], k->second, "Wrong event order");
+    }
+}
+
+class SimulatorCompactionTestCase : public TestCase
+{
+public:
+  SimulatorCompactionTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Live (uint32_t index);
+  void Dead (void);
+  ObjectFactory m_schedulerFactory;
+  std::vector<uint32_t> m_order;
+  uint32_t m_dead;
+};
+
+SimulatorCompactionTestCase::SimulatorCompactionTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check the compaction of the cancelled events with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SimulatorCompactionTestCase::Live (uint32_t index)
+{
+  m_order.push_back (index);
+}
+
+void
+SimulatorCompactionTestCase::Dead (void)
+{
+  m_dead++;
+}
+
+void
+SimulatorCompactionTestCase::DoRun (void)
+{
+  Simulator::Destroy ();
+  Simulator::SetScheduler (m_schedulerFactory);
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_EQ ((impl != 0), true, "Expected a DefaultSimulatorImpl");
+  impl->SetAttribute ("CompactionMinimum", UintegerValue (100));
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  m_order.clear ();
+  m_dead = 0;
+
+  // live events, and a timer which is rescheduled many times
+  std::multimap<int64_t, uint32_t> expected;
+  EventId timer;
+  EventId removed;
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      if (i % 5 == 0)
+        {
+          Time delay = MicroSeconds (random->GetInteger (0, 1000));
+          EventId id = Simulator::Schedule (delay, &SimulatorCompactionTestCase::Live, this, i);
+          if (i == 2500)
+            {
+              removed = id;
+            }
+          else
+            {
+              expected.insert (std::make_pair (delay.GetTimeStep (), i));
+            }
+        }
+      timer.Cancel ();
+      timer = Simulator::Schedule (MicroSeconds (random->GetInteger (0, 1000)),
+                                   &SimulatorCompactionTestCase::Dead, this);
+    }
+  timer.Cancel ();
+  // an event which survives the compactions can still be removed
+  Simulator::Remove (removed);
+
+  DefaultSimulatorImpl::CancelStats stats = impl->GetCancelStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.cancelled, 5000, "Wrong count of cancelled events");
+  NS_TEST_ASSERT_MSG_GT (stats.compactions, 0, "The scheduler should have been compacted");
+  NS_TEST_ASSERT_MSG_EQ (stats.compacted + stats.pendingCancelled, stats.cancelled,
+                         "Cancelled events lost");
+  NS_TEST_ASSERT_MSG_EQ (stats.pending, expected.size () + stats.pendingCancelled,
+                         "Wrong count of pending events");
+  NS_TEST_ASSERT_MSG_LT (stats.pendingCancelled, 1000, "Too many cancelled events left");
+
+  impl = 0;
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_dead, 0, "A cancelled event ran");
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), expected.size (), "Wrong number of events");
+  std::multimap<int64_t, uint32_t>::const_iterator k = expected.begin ();
+  for (uint32_t i = 0; i < m_order.size (); i++, k++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_order[i], k->second, "Wrong event order");
+    }
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -475,5 +737,22 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    const TypeId schedulers[] = {
+      ListScheduler::GetTypeId (),
+      MapScheduler::GetTypeId (),
+      HeapScheduler::GetTypeId (),
+      CalendarScheduler::GetTypeId (),
+      LadderScheduler::GetTypeId ()
+    };
+    for (uint32_t i = 0; i < sizeof (schedulers) / sizeof (schedulers[0]); i++)
+      {
+        factory.SetTypeId (schedulers[i]);
+        AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+        AddTestCase (new SimulatorBatchTestCase (factory), TestCase::QUICK);
+        AddTestCase (new SimulatorCompactionTestCase (factory), TestCase::QUICK);
+      }
   }
 } g_simulatorTestSuite;
@@ -20,10 +20,12 @@
  * TimeStep support by Emmanuelle Laprise <emmanuelle.laprise@bluekazoo.ca>
  */
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "ns3/nstime.h"
 #include "ns3/int64x64.h"
@@ -230,6 +232,69 @@ TimeInputOutputTestCase::DoRun (void)
   std::cout << std::endl;
 }
     
+class TimeConversionTestCase : public TestCase
+{
+public:
+  TimeConversionTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+TimeConversionTestCase::TimeConversionTestCase ()
+  : TestCase ("Check the conversions of the default resolution against int64x64_t")
+{
+}
+
+void
+TimeConversionTestCase::DoRun (void)
+{
+  const Time::Unit units[] = { Time::Y, Time::D, Time::H, Time::MIN,
+                               Time::S, Time::MS, Time::US, Time::NS };
+  std::vector<double> values;
+  values.push_back (0);
+  values.push_back (0.1);
+  values.push_back (0.3);
+  values.push_back (1.0 / 3);
+  values.push_back (1e-9);
+  values.push_back (2.5e-10);
+  values.push_back (1.5e-9);
+  values.push_back (123.456789);
+  // pseudo-random values from 1e-12 to 1e6, of both signs
+  uint32_t state = 1;
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      state = state * 1664525 + 1013904223;
+      double mantissa = 1 + state / 4294967296.0;
+      values.push_back ((i % 2 ? -1 : 1) * mantissa * std::pow (10.0, int (i % 19) - 12));
+    }
+
+  for (uint32_t u = 0; u < sizeof (units) / sizeof (units[0]); u++)
+    {
+      for (std::vector<double>::const_iterator v = values.begin (); v != values.end (); ++v)
+        {
+          // keep the values of the coarse units in range
+          double value = units[u] < Time::S ? *v / 1e6 : *v;
+          Time fast = Time::FromDouble (value, units[u]);
+          Time general = Time::From (int64x64_t (value), units[u]);
+          NS_TEST_ASSERT_MSG_EQ (fast.GetTimeStep (), general.GetTimeStep (),
+                                 "FromDouble (" << value << ", " << units[u] << ")");
+          NS_TEST_ASSERT_MSG_EQ (fast.ToDouble (units[u]), fast.To (units[u]).GetDouble (),
+                                 "ToDouble (" << units[u] << ") of " << fast);
+        }
+      // 123 years still fit in the nanoseconds of an int64_t
+      uint64_t integer = 123;
+      NS_TEST_ASSERT_MSG_EQ (Time::FromInteger (integer, units[u]),
+                             Time::From (int64x64_t (integer), units[u]),
+                             "FromInteger (" << integer << ", " << units[u] << ")");
+      NS_TEST_ASSERT_MSG_EQ (Time::FromInteger (integer, units[u]).ToInteger (units[u]), 123,
+                             "ToInteger (" << units[u] << ")");
+    }
+  NS_TEST_ASSERT_MSG_EQ (Seconds (0.3).GetNanoSeconds (),
+                         Time::From (int64x64_t (0.3), Time::S).GetNanoSeconds (),
+                         "Seconds (0.3)");
+  NS_TEST_ASSERT_MSG_EQ (MilliSeconds (1500).GetSeconds (), 1.5, "GetSeconds");
+}
+
 static class TimeTestSuite : public TestSuite
 {
 public:
@@ -238,6 +303,7 @@ public:
   {
     AddTestCase (new TimeWithSignTestCase (), TestCase::QUICK);
     AddTestCase (new TimeInputOutputTestCase (), TestCase::QUICK);
+    AddTestCase (new TimeConversionTestCase (), TestCase::QUICK);
     // This should be last, since it changes the resolution
     AddTestCase (new TimeSimpleTestCase (), TestCase::QUICK);
   }
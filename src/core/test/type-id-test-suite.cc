@@ -25,6 +25,10 @@
 #include "ns3/type-id.h"
 #include "ns3/test.h"
 #include "ns3/log.h"
+#include "ns3/object.h"
+#include "ns3/object-factory.h"
+#include "ns3/uinteger.h"
+#include "ns3/config.h"
 
 using namespace std;
 
@@ -180,6 +184,13 @@ CollisionTestCase::DoRun (void)
                           "Second and lesser TypeId has HashChainFlag set");
   cout << suite << "collision: second,lesser not chained: OK" << endl;
 
+  // Check that the colliding names are found
+  NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByName (t1Name), t1, "First chained TypeId not found by name");
+  NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByName (t2Name), t2, "Second chained TypeId not found by name");
+  NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByName (t3Name), t3, "Third chained TypeId not found by name");
+  NS_TEST_ASSERT_MSG_EQ (TypeId::LookupByName (t4Name), t4, "Fourth chained TypeId not found by name");
+  cout << suite << "collision: lookup by name: OK" << endl;
+
   /** TODO Extra credit:  register three types whose hashes collide
    *
    *  None found in /usr/share/dict/web2
@@ -188,6 +199,115 @@ CollisionTestCase::DoRun (void)
 }
   
   
+//----------------------------
+//
+// Attribute table test
+
+class AttributeTableBase : public Object
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::AttributeTableBase")
+      .SetParent<Object> ()
+      .SetGroupName ("Core")
+      .HideFromDocumentation ()
+      .AddConstructor<AttributeTableBase> ()
+      .AddAttribute ("A", "The first attribute of the base.",
+                     UintegerValue (1),
+                     MakeUintegerAccessor (&AttributeTableBase::m_a),
+                     MakeUintegerChecker<uint32_t> ())
+      .AddAttribute ("B", "The second attribute of the base.",
+                     UintegerValue (2),
+                     MakeUintegerAccessor (&AttributeTableBase::m_b),
+                     MakeUintegerChecker<uint32_t> ())
+      ;
+    return tid;
+  }
+  uint32_t m_a;
+  uint32_t m_b;
+};
+
+class AttributeTableDerived : public AttributeTableBase
+{
+public:
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::AttributeTableDerived")
+      .SetParent<AttributeTableBase> ()
+      .SetGroupName ("Core")
+      .HideFromDocumentation ()
+      .AddConstructor<AttributeTableDerived> ()
+      .AddAttribute ("C", "The attribute of the derived type.",
+                     UintegerValue (3),
+                     MakeUintegerAccessor (&AttributeTableDerived::m_c),
+                     MakeUintegerChecker<uint32_t> ())
+      ;
+    return tid;
+  }
+  uint32_t m_c;
+};
+
+class AttributeTableTestCase : public TestCase
+{
+public:
+  AttributeTableTestCase ();
+  virtual ~AttributeTableTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+AttributeTableTestCase::AttributeTableTestCase ()
+  : TestCase ("Check the attribute tables")
+{
+}
+
+AttributeTableTestCase::~AttributeTableTestCase ()
+{
+}
+
+void
+AttributeTableTestCase::DoRun (void)
+{
+  TypeId tid = AttributeTableDerived::GetTypeId ();
+  Ptr<const TypeId::AttributeTable> table = tid.GetAttributeTable ();
+
+  // the attributes of the type come first, then those of the parents
+  NS_TEST_ASSERT_MSG_EQ (table->attributes.size (), 3, "Wrong number of attributes");
+  NS_TEST_EXPECT_MSG_EQ (table->attributes[0].fullName, "ns3::AttributeTableDerived::C", "Wrong first attribute");
+  NS_TEST_EXPECT_MSG_EQ (table->attributes[1].fullName, "ns3::AttributeTableBase::A", "Wrong second attribute");
+  NS_TEST_EXPECT_MSG_EQ (table->attributes[2].fullName, "ns3::AttributeTableBase::B", "Wrong third attribute");
+  NS_TEST_EXPECT_MSG_EQ (table->attributes[2].index, 1, "Wrong index in the registering type");
+
+  NS_TEST_EXPECT_MSG_EQ (table->Find ("B"), 2, "Attribute not found by name");
+  NS_TEST_EXPECT_MSG_EQ (table->Find ("D"), TypeId::AttributeTable::NOT_FOUND, "Missing attribute found");
+  NS_TEST_EXPECT_MSG_EQ (table->Find (table->attributes[1].info.checker), 1, "Attribute not found by checker");
+  struct TypeId::AttributeInformation info;
+  NS_TEST_EXPECT_MSG_EQ (tid.LookupAttributeByName ("A", &info), true, "Attribute of the parent not found");
+  NS_TEST_EXPECT_MSG_EQ (info.name, "A", "Wrong attribute found");
+  NS_TEST_EXPECT_MSG_EQ ((tid.GetAttributeTable () == table), true, "The table is not shared");
+
+  // construction with a value, and the initial values
+  ObjectFactory factory;
+  factory.SetTypeId (tid);
+  factory.Set ("B", UintegerValue (20));
+  Ptr<AttributeTableDerived> object = factory.Create<AttributeTableDerived> ();
+  NS_TEST_EXPECT_MSG_EQ (object->m_a, 1, "Wrong initial value");
+  NS_TEST_EXPECT_MSG_EQ (object->m_b, 20, "Wrong value of the factory");
+  NS_TEST_EXPECT_MSG_EQ (object->m_c, 3, "Wrong initial value");
+
+  // a new initial value replaces the table
+  Config::SetDefault ("ns3::AttributeTableBase::A", UintegerValue (10));
+  NS_TEST_EXPECT_MSG_EQ ((tid.GetAttributeTable () == table), false, "The table was not recomputed");
+  object = CreateObject<AttributeTableDerived> ();
+  NS_TEST_EXPECT_MSG_EQ (object->m_a, 10, "Initial value not changed");
+  // the attributes of the parents are not set by the name of the type
+  NS_TEST_EXPECT_MSG_EQ (Config::SetDefaultFailSafe ("ns3::AttributeTableDerived::A", UintegerValue (5)), false,
+                         "Attribute of the parent set by the name of the type");
+  Config::SetDefault ("ns3::AttributeTableBase::A", UintegerValue (1));
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -298,6 +418,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   // as chained.
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
+  AddTestCase (new AttributeTableTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
@@ -22,6 +22,8 @@
 #include "csma-net-device.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/event-batch.h"
+#include "ns3/make-event.h"
 #include "ns3/log.h"
 
 namespace ns3 {
@@ -222,6 +224,7 @@ CsmaChannel::TransmitEnd ()
 
   NS_LOG_LOGIC ("Receive");
 
+  EventBatch batch;
   std::vector<CsmaDeviceRec>::iterator it;
   uint32_t devId = 0;
   for (it = m_deviceList.begin (); it < m_deviceList.end (); it++)
@@ -229,13 +232,13 @@ CsmaChannel::TransmitEnd ()
       if (it->IsActive ())
         {
           // schedule reception events
-          Simulator::ScheduleWithContext (it->devicePtr->GetNode ()->GetId (),
-                                          m_delay,
-                                          &CsmaNetDevice::Receive, it->devicePtr,
-                                          m_currentPkt->Copy (), m_deviceList[m_currentSrc].devicePtr);
+          batch.Add (it->devicePtr->GetNode ()->GetId (), m_delay,
+                     MakeEvent (&CsmaNetDevice::Receive, it->devicePtr,
+                                m_currentPkt->Copy (), m_deviceList[m_currentSrc].devicePtr));
         }
       devId++;
     }
+  Simulator::ScheduleBatch (batch);
 
   // also schedule for the tx side to go back to IDLE
   Simulator::Schedule (m_delay, &CsmaChannel::PropagationCompleteEvent,
@@ -0,0 +1,368 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tag.h"
+#include "ns3/tag-buffer.h"
+#include "ns3/packet-tag-list.h"
+
+/**
+ * \file
+ * \ingroup packet
+ * Compare the PacketTagList with the copy-on-write linked list of
+ * TagData nodes it replaced, for 1 to 8 tags per packet.
+ *
+ * Each list is measured on the operations of a packet which crosses a
+ * few layers: the tags are added to an empty list, a copy of a list is
+ * searched for each of its tags and for a missing one, and the tags are
+ * removed from a copy of a list, one by one.
+ *
+ * \code
+ *   ./waf --run "packet-tag-benchmark --operations=1000000"
+ * \endcode
+ */
+
+using namespace ns3;
+
+/**
+ * A tag of 8 bytes, one type per value of N.
+ */
+template <int N>
+class BenchTag : public Tag
+{
+public:
+  /** Constructor. */
+  BenchTag ()
+    : m_data (N)
+  {
+  }
+  /**
+   * Register this type.
+   * \returns The TypeId.
+   */
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId (GetTypeName ().c_str ())
+      .SetParent<Tag> ()
+      .SetGroupName ("Network")
+      .AddConstructor<BenchTag<N> > ()
+    ;
+    return tid;
+  }
+  virtual TypeId GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+  virtual uint32_t GetSerializedSize (void) const
+  {
+    return 8;
+  }
+  virtual void Serialize (TagBuffer i) const
+  {
+    i.WriteU64 (m_data);
+  }
+  virtual void Deserialize (TagBuffer i)
+  {
+    m_data = i.ReadU64 ();
+  }
+  virtual void Print (std::ostream &os) const
+  {
+    os << m_data;
+  }
+private:
+  /** \returns The name of the type. */
+  static std::string GetTypeName (void)
+  {
+    std::ostringstream oss;
+    oss << "ns3::BenchTag<" << N << ">";
+    return oss.str ();
+  }
+
+  uint64_t m_data; //!< The value of the tag
+};
+
+/**
+ * The copy-on-write linked list of the previous PacketTagList, for
+ * reference: each tag is a node allocated with new, and the lists
+ * share their tails.
+ */
+class LinkedPacketTagList
+{
+public:
+  /** A node of the list. */
+  struct TagData
+  {
+    uint8_t data[PacketTagList::TagData::MAX_SIZE]; //!< Serialization buffer
+    struct TagData *next;                           //!< Next node
+    TypeId tid;                                     //!< Type of the tag
+    uint32_t count;                                 //!< Number of incoming links
+  };
+
+  LinkedPacketTagList ()
+    : m_next (0)
+  {
+  }
+  /**
+   * Copy constructor: share the nodes of another list.
+   * \param [in] o The list.
+   */
+  LinkedPacketTagList (const LinkedPacketTagList &o)
+    : m_next (o.m_next)
+  {
+    if (m_next != 0)
+      {
+        m_next->count++;
+      }
+  }
+  ~LinkedPacketTagList ()
+  {
+    RemoveAll ();
+  }
+  /** Release the nodes up to the first merge. */
+  void RemoveAll (void)
+  {
+    struct TagData *prev = 0;
+    for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+      {
+        cur->count--;
+        if (cur->count > 0)
+          {
+            break;
+          }
+        delete prev;
+        prev = cur;
+      }
+    delete prev;
+    m_next = 0;
+  }
+  /**
+   * Prepend a tag.
+   * \param [in] tag The tag.
+   */
+  void Add (const Tag &tag)
+  {
+    struct TagData *head = new struct TagData ();
+    head->count = 1;
+    head->tid = tag.GetInstanceTypeId ();
+    head->next = m_next;
+    tag.Serialize (TagBuffer (head->data, head->data + tag.GetSerializedSize ()));
+    m_next = head;
+  }
+  /**
+   * Find a tag.
+   * \param [in,out] tag The tag.
+   * \returns true if the tag was found.
+   */
+  bool Peek (Tag &tag) const
+  {
+    TypeId tid = tag.GetInstanceTypeId ();
+    for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+      {
+        if (cur->tid == tid)
+          {
+            tag.Deserialize (TagBuffer (cur->data, cur->data + PacketTagList::TagData::MAX_SIZE));
+            return true;
+          }
+      }
+    return false;
+  }
+  /**
+   * Remove a tag, copying the shared nodes which precede it.
+   * \param [in,out] tag The tag.
+   * \returns true if the tag was found.
+   */
+  bool Remove (Tag &tag)
+  {
+    TypeId tid = tag.GetInstanceTypeId ();
+    struct TagData **prevNext = &m_next;
+    struct TagData *cur = m_next;
+    // before the first merge, unlink in place
+    while (cur != 0 && cur->count == 1)
+      {
+        if (cur->tid == tid)
+          {
+            tag.Deserialize (TagBuffer (cur->data, cur->data + PacketTagList::TagData::MAX_SIZE));
+            *prevNext = cur->next;
+            delete cur;
+            return true;
+          }
+        prevNext = &cur->next;
+        cur = cur->next;
+      }
+    struct TagData *it = cur;
+    while (it != 0 && it->tid != tid)
+      {
+        it = it->next;
+      }
+    if (it == 0)
+      {
+        return false;
+      }
+    // after the first merge, copy the nodes up to the tag
+    while (cur->tid != tid)
+      {
+        cur->count--;
+        struct TagData *copy = new struct TagData ();
+        copy->tid = cur->tid;
+        copy->count = 1;
+        std::memcpy (copy->data, cur->data, PacketTagList::TagData::MAX_SIZE);
+        copy->next = cur->next;
+        copy->next->count++;
+        *prevNext = copy;
+        prevNext = &copy->next;
+        cur = copy->next;
+      }
+    tag.Deserialize (TagBuffer (cur->data, cur->data + PacketTagList::TagData::MAX_SIZE));
+    *prevNext = cur->next;
+    cur->count--;
+    if (cur->next != 0)
+      {
+        cur->next->count++;
+      }
+    return true;
+  }
+private:
+  /**
+   * Assignment: not implemented.
+   * \param [in] o The list.
+   * \returns This list.
+   */
+  LinkedPacketTagList & operator = (const LinkedPacketTagList &o);
+
+  struct TagData *m_next; //!< First node
+};
+
+/**
+ * Measure the operations of a list.
+ *
+ * \param [in] tags The tags: the first n are in the lists, the next one is not.
+ * \param [in] n The number of tags of a list.
+ * \param [in] operations The number of lists of each measure.
+ * \param [out] ms The run times of the add, copy and peek, and copy
+ *              and remove measures, in milliseconds.
+ * \returns The number of tags found, to keep the results alive.
+ */
+template <typename List>
+uint64_t
+Bench (const std::vector<Tag *> &tags, uint32_t n, uint32_t operations, int64_t ms[3])
+{
+  SystemWallClockMs clock;
+  uint64_t found = 0;
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      List list;
+      for (uint32_t j = 0; j < n; j++)
+        {
+          list.Add (*tags[j]);
+        }
+    }
+  ms[0] = clock.End ();
+
+  List ref;
+  for (uint32_t j = 0; j < n; j++)
+    {
+      ref.Add (*tags[j]);
+    }
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      List list (ref);
+      for (uint32_t j = 0; j <= n; j++)
+        {
+          found += list.Peek (*tags[j]);
+        }
+    }
+  ms[1] = clock.End ();
+
+  clock.Start ();
+  for (uint32_t i = 0; i < operations; i++)
+    {
+      List list (ref);
+      for (uint32_t j = 0; j < n; j++)
+        {
+          found += list.Remove (*tags[j]);
+        }
+    }
+  ms[2] = clock.End ();
+
+  return found;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t operations = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("operations", "Number of lists of each measure", operations);
+  cmd.Parse (argc, argv);
+
+  std::vector<Tag *> tags;
+  tags.push_back (new BenchTag<1> ());
+  tags.push_back (new BenchTag<2> ());
+  tags.push_back (new BenchTag<3> ());
+  tags.push_back (new BenchTag<4> ());
+  tags.push_back (new BenchTag<5> ());
+  tags.push_back (new BenchTag<6> ());
+  tags.push_back (new BenchTag<7> ());
+  tags.push_back (new BenchTag<8> ());
+  tags.push_back (new BenchTag<9> ());
+
+  const char *names[3] = { "add", "copy+peek", "copy+remove" };
+  std::cout << std::left << std::setw (6) << "tags"
+            << std::setw (14) << "operation"
+            << std::right << std::setw (12) << "linked ms"
+            << std::setw (12) << "array ms"
+            << std::setw (10) << "speedup"
+            << std::endl;
+
+  uint64_t found = 0;
+  for (uint32_t n = 1; n <= 8; n++)
+    {
+      int64_t linked[3];
+      int64_t array[3];
+      found += Bench<LinkedPacketTagList> (tags, n, operations, linked);
+      found += Bench<PacketTagList> (tags, n, operations, array);
+      for (uint32_t k = 0; k < 3; k++)
+        {
+          std::cout << std::left << std::setw (6) << n
+                    << std::setw (14) << names[k]
+                    << std::right << std::setw (12) << linked[k]
+                    << std::setw (12) << array[k]
+                    << std::setw (10) << std::fixed << std::setprecision (2)
+                    << (array[k] > 0 ? double (linked[k]) / array[k] : 0.0)
+                    << std::endl;
+        }
+    }
+
+  // keep the results alive
+  std::cout << "checksum " << found << std::endl;
+  for (uint32_t j = 0; j < tags.size (); j++)
+    {
+      delete tags[j];
+    }
+  return 0;
+}
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-partition-helper.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedPartitionHelper");
+
+MultithreadedPartitionHelper::MultithreadedPartitionHelper ()
+  : m_partitionCount (0)
+{
+}
+
+void
+MultithreadedPartitionHelper::SetPartitionCount (uint32_t count)
+{
+  m_partitionCount = count;
+}
+
+void
+MultithreadedPartitionHelper::SetPartition (Ptr<Node> node, uint32_t partition)
+{
+  m_partitions[node->GetId ()] = partition;
+}
+
+void
+MultithreadedPartitionHelper::SetPartition (NodeContainer nodes, uint32_t partition)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      SetPartition (*i, partition);
+    }
+}
+
+Ptr<MultithreadedSimulatorImpl>
+MultithreadedPartitionHelper::GetImplementation (void) const
+{
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_ABORT_MSG_IF (impl == 0, "MultithreadedPartitionHelper requires SimulatorImplementationType "
+                   "to be ns3::MultithreadedSimulatorImpl");
+  return impl;
+}
+
+uint32_t
+MultithreadedPartitionHelper::GetPartition (Ptr<Node> node) const
+{
+  std::map<uint32_t, uint32_t>::const_iterator i = m_partitions.find (node->GetId ());
+  if (i != m_partitions.end ())
+    {
+      return i->second;
+    }
+  uint32_t count = m_partitionCount;
+  if (count == 0)
+    {
+      count = GetImplementation ()->GetPartitionCount ();
+    }
+  // contiguous blocks of node ids keep neighbours together in
+  // topologies built with the usual helpers.
+  return static_cast<uint64_t> (node->GetId ()) * count / NodeList::GetNNodes ();
+}
+
+Time
+MultithreadedPartitionHelper::CalculateLookAhead (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Time lookAhead = Simulator::GetMaximumSimulationTime ();
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); ++node)
+    {
+      uint32_t partition = GetPartition (*node);
+      for (uint32_t i = 0; i < (*node)->GetNDevices (); ++i)
+        {
+          Ptr<NetDevice> localNetDevice = (*node)->GetDevice (i);
+          // only works for p2p links currently
+          if (!localNetDevice->IsPointToPoint ())
+            {
+              continue;
+            }
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+
+          // grab the adjacent node
+          Ptr<Node> remoteNode;
+          if (channel->GetDevice (0) == localNetDevice)
+            {
+              remoteNode = (channel->GetDevice (1))->GetNode ();
+            }
+          else
+            {
+              remoteNode = (channel->GetDevice (0))->GetNode ();
+            }
+
+          // if it's in the same partition, don't consider it
+          if (GetPartition (remoteNode) == partition)
+            {
+              continue;
+            }
+
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          if (delay.Get () < lookAhead)
+            {
+              lookAhead = delay.Get ();
+            }
+        }
+    }
+  NS_LOG_LOGIC ("lookahead " << lookAhead);
+  return lookAhead;
+}
+
+void
+MultithreadedPartitionHelper::Install (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<MultithreadedSimulatorImpl> impl = GetImplementation ();
+  if (m_partitionCount != 0)
+    {
+      impl->SetPartitionCount (m_partitionCount);
+    }
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); ++node)
+    {
+      impl->SetPartition ((*node)->GetId (), GetPartition (*node));
+    }
+  impl->SetLookAhead (CalculateLookAhead ());
+}
+
+} // namespace ns3
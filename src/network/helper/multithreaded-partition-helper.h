@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MULTITHREADED_PARTITION_HELPER_H
+#define MULTITHREADED_PARTITION_HELPER_H
+
+#include <stdint.h>
+#include <map>
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+class MultithreadedSimulatorImpl;
+
+/**
+ * \brief Split the nodes of a topology into the partitions of a
+ * MultithreadedSimulatorImpl.
+ *
+ * Nodes can be assigned to a partition explicitly; the others are
+ * split by node id into contiguous blocks of equal size.  Install()
+ * then computes the lookahead from the point-to-point channels which
+ * join two partitions, the same way DistributedSimulatorImpl does for
+ * the links between two MPI ranks, and configures the simulator.
+ *
+ * \code
+ *   Config::SetGlobal ("SimulatorImplementationType",
+ *                      StringValue ("ns3::MultithreadedSimulatorImpl"));
+ *   // ... build the topology ...
+ *   MultithreadedPartitionHelper partitions;
+ *   partitions.SetPartitionCount (16);
+ *   partitions.Install ();
+ *   Simulator::Run ();
+ * \endcode
+ */
+class MultithreadedPartitionHelper
+{
+public:
+  MultithreadedPartitionHelper ();
+
+  /**
+   * \param count the number of partitions; zero keeps the partition
+   *        count of the simulator.
+   */
+  void SetPartitionCount (uint32_t count);
+  /**
+   * \param node the node to assign
+   * \param partition the partition which runs the events of this node
+   */
+  void SetPartition (Ptr<Node> node, uint32_t partition);
+  /**
+   * \param nodes the nodes to assign
+   * \param partition the partition which runs the events of these nodes
+   */
+  void SetPartition (NodeContainer nodes, uint32_t partition);
+  /**
+   * \param node a node
+   * \returns the partition the node is assigned to by this helper.
+   */
+  uint32_t GetPartition (Ptr<Node> node) const;
+  /**
+   * \returns the smallest delay of the point-to-point channels which
+   *          join two partitions, or Simulator::GetMaximumSimulationTime
+   *          if there is none.
+   */
+  Time CalculateLookAhead (void) const;
+  /**
+   * Configure the partitions and the lookahead of the current
+   * simulator implementation, which must be a MultithreadedSimulatorImpl.
+   * Must be called after the topology is built and before
+   * Simulator::Run.
+   */
+  void Install (void) const;
+
+private:
+  /**
+   * \returns the simulator implementation.
+   */
+  Ptr<MultithreadedSimulatorImpl> GetImplementation (void) const;
+
+  uint32_t m_partitionCount;                   //!< Number of partitions
+  std::map<uint32_t, uint32_t> m_partitions;   //!< Explicit assignments, by node id
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_PARTITION_HELPER_H */
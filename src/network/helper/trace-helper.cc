@@ -295,6 +295,18 @@ AsciiTraceHelper::GetFilenameFromInterfacePair (
   return oss.str ();
 }
 
+Ptr<OutputStreamWrapper>
+AsciiTraceHelper::CreateBinaryFileStream (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> ();
+  file->Open (filename, std::ios::out);
+  NS_ABORT_MSG_IF (file->Fail (), "AsciiTraceHelper::CreateBinaryFileStream():  Unable to Open " << filename);
+
+  return Create<OutputStreamWrapper> (file);
+}
+
 //
 // One of the basic default trace sink sets.  Enqueue:
 //
@@ -310,6 +322,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::ENQUEUE, Simulator::Now (), p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -317,6 +335,12 @@ void
 AsciiTraceHelper::DefaultEnqueueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::ENQUEUE, Simulator::Now (), context, p);
+      return;
+    }
   *stream->GetStream () << "+ " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -336,6 +360,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::DROP, Simulator::Now (), p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -343,6 +373,12 @@ void
 AsciiTraceHelper::DefaultDropSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::DROP, Simulator::Now (), context, p);
+      return;
+    }
   *stream->GetStream () << "d " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -363,6 +399,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::DEQUEUE, Simulator::Now (), p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -370,6 +412,12 @@ void
 AsciiTraceHelper::DefaultDequeueSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::DEQUEUE, Simulator::Now (), context, p);
+      return;
+    }
   *stream->GetStream () << "- " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
@@ -387,6 +435,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithoutContext (Ptr<OutputStreamWrapper> stream, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::RECEIVE, Simulator::Now (), p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << *p << std::endl;
 }
 
@@ -394,6 +448,12 @@ void
 AsciiTraceHelper::DefaultReceiveSinkWithContext (Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (stream << p);
+  Ptr<BinaryTraceFile> file = stream->GetBinaryFile ();
+  if (file != 0)
+    {
+      file->Write (BinaryTraceFile::RECEIVE, Simulator::Now (), context, p);
+      return;
+    }
   *stream->GetStream () << "r " << Simulator::Now ().GetSeconds () << " " << context << " " << *p << std::endl;
 }
 
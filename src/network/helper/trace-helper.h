@@ -216,6 +216,20 @@ public:
   Ptr<OutputStreamWrapper> CreateFileStream (std::string filename, 
                                              std::ios::openmode filemode = std::ios::out);
 
+  /**
+   * @brief Create an output stream object which stores the traced bits in
+   * a binary file, rather than as text.
+   *
+   * The default trace sinks store a binary record of each event in the
+   * BinaryTraceFile of the stream, and the other sinks, which print text
+   * to the stream, store text records.  The convert-binary-trace program
+   * prints the text of the records of the file, or of a window of time.
+   *
+   * @param filename file name
+   * @returns a smart pointer to the output stream
+   */
+  Ptr<OutputStreamWrapper> CreateBinaryFileStream (std::string filename);
+
   /**
    * @brief Hook a trace source to the default enqueue operation trace sink that
    * does not accept nor log a trace context.
@@ -52,67 +52,22 @@ NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use 
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy 
- * constructor orderings.
+/**
+ * The free lists of the Buffer::Data instances. The buffers created or
+ * destroyed by the static constructors or destructors which run before
+ * or after those of this compilation unit bypass it.
  */
-#define MAGIC_DESTROYED (~(long) 0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
-{
-  NS_LOG_FUNCTION (this);
-  if (IS_INITIALIZED (g_freeList))
-    {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
-        {
-          Buffer::Deallocate (*i);
-        }
-      delete g_freeList;
-      g_freeList = DESTROYED;
-    }
-}
+static DataCache g_cache (1000, 4000);
 
 void
 Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+  if (!g_cache.Put (reinterpret_cast<uint8_t *> (data), data->m_size))
     {
       Buffer::Deallocate (data);
     }
-  else
-    {
-      NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
-    }
 }
 
 Buffer::Data *
@@ -120,28 +75,23 @@ Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
   /* try to find a buffer correctly sized. */
-  if (IS_UNINITIALIZED (g_freeList))
+  uint8_t *block = g_cache.Get (dataSize);
+  if (block != 0)
     {
-      g_freeList = new Buffer::FreeList ();
-    }
-  else if (IS_INITIALIZED (g_freeList))
-    {
-      while (!g_freeList->empty ()) 
-        {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
-        }
+      struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data *> (block);
+      data->m_count = 1;
+      return data;
     }
   struct Buffer::Data *data = Buffer::Allocate (dataSize);
   NS_ASSERT (data->m_count == 1);
   return data;
 }
+
+DataCache::Stats
+Buffer::GetCacheStats (void)
+{
+  return g_cache.GetStats ();
+}
 #else /* BUFFER_FREE_LIST */
 void
 Buffer::Recycle (struct Buffer::Data *data)
@@ -157,6 +107,12 @@ Buffer::Create (uint32_t size)
   NS_LOG_FUNCTION (size);
   return Allocate (size);
 }
+
+DataCache::Stats
+Buffer::GetCacheStats (void)
+{
+  return DataCache::Stats ();
+}
 #endif /* BUFFER_FREE_LIST */
 
 struct Buffer::Data *
@@ -400,39 +356,173 @@ void
 Buffer::AddAtEnd (const Buffer &o)
 {
   NS_LOG_FUNCTION (this << &o);
-  if (m_data->m_count == 1 &&
-      m_end == m_zeroAreaEnd &&
-      m_end == m_data->m_dirtyEnd &&
+  uint32_t zeroSize = m_zeroAreaEnd - m_zeroAreaStart;
+  uint32_t oZeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+  if (m_end == m_zeroAreaEnd &&
       o.m_start == o.m_zeroAreaStart &&
-      o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+      oZeroSize > 0)
     {
       /**
        * This is an optimization which kicks in when
        * we attempt to aggregate two buffers which contain
        * adjacent zero areas.
        */
-      uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
-      m_zeroAreaEnd += zeroSize;
-      m_end = m_zeroAreaEnd;
-      m_data->m_dirtyEnd = m_zeroAreaEnd;
       uint32_t endData = o.m_end - o.m_zeroAreaEnd;
-      AddAtEnd (endData);
-      Buffer::Iterator dst = End ();
-      dst.Prev (endData);
-      Buffer::Iterator src = o.End ();
-      src.Prev (endData);
-      dst.Write (src, o.End ());
+      if (m_data->m_count == 1 &&
+          m_end == m_data->m_dirtyEnd)
+        {
+          m_zeroAreaEnd += oZeroSize;
+          m_end = m_zeroAreaEnd;
+          m_data->m_dirtyEnd = m_zeroAreaEnd;
+          AddAtEnd (endData);
+          Buffer::Iterator dst = End ();
+          dst.Prev (endData);
+          Buffer::Iterator src = o.End ();
+          src.Prev (endData);
+          dst.Write (src, o.End ());
+          NS_ASSERT (CheckInternalState ());
+          return;
+        }
+      // the data is shared: copy the real bytes only
+      uint32_t startData = m_zeroAreaStart - m_start;
+      Buffer dst (zeroSize + oZeroSize);
+      dst.AddAtStart (startData);
+      dst.Begin ().Write (m_data->m_data + m_start, startData);
+      dst.AddAtEnd (endData);
+      Buffer::Iterator i = dst.End ();
+      i.Prev (endData);
+      i.Write (o.m_data->m_data + o.m_zeroAreaStart, endData);
+      *this = dst;
       NS_ASSERT (CheckInternalState ());
       return;
     }
 
-  Buffer dst = CreateFullCopy ();
-  Buffer src = o.CreateFullCopy ();
+  /**
+   * The buffer can keep a single zero area: keep the larger one,
+   * and write the zero bytes of the other one.
+   */
+  if (zeroSize >= oZeroSize)
+    {
+      uint32_t size = o.GetSize ();
+      if (m_data->m_count == 1 && m_data != o.m_data)
+        {
+          AddAtEnd (size);
+          Buffer::Iterator dst = End ();
+          dst.Prev (size);
+          dst.Write (o.Begin (), o.End ());
+          NS_ASSERT (CheckInternalState ());
+          return;
+        }
+      uint32_t startData = m_zeroAreaStart - m_start;
+      uint32_t endData = m_end - m_zeroAreaEnd;
+      Buffer dst (zeroSize);
+      dst.AddAtStart (startData);
+      dst.Begin ().Write (m_data->m_data + m_start, startData);
+      dst.AddAtEnd (endData + size);
+      Buffer::Iterator i = dst.End ();
+      i.Prev (endData + size);
+      i.Write (m_data->m_data + m_zeroAreaStart, endData);
+      i.Write (o.Begin (), o.End ());
+      *this = dst;
+    }
+  else
+    {
+      uint32_t size = GetSize ();
+      uint32_t startData = o.m_zeroAreaStart - o.m_start;
+      uint32_t endData = o.m_end - o.m_zeroAreaEnd;
+      Buffer dst (oZeroSize);
+      dst.AddAtStart (size + startData);
+      Buffer::Iterator i = dst.Begin ();
+      i.Write (Begin (), End ());
+      i.Write (o.m_data->m_data + o.m_start, startData);
+      dst.AddAtEnd (endData);
+      i = dst.End ();
+      i.Prev (endData);
+      i.Write (o.m_data->m_data + o.m_zeroAreaStart, endData);
+      *this = dst;
+    }
+  NS_ASSERT (CheckInternalState ());
+}
+
+void
+Buffer::AddAtEnd (const std::vector<Buffer> &buffers)
+{
+  NS_LOG_FUNCTION (this << buffers.size ());
+  if (buffers.size () <= 1)
+    {
+      if (!buffers.empty ())
+        {
+          AddAtEnd (buffers.front ());
+        }
+      return;
+    }
+  std::vector<const Buffer *> parts;
+  parts.reserve (buffers.size () + 1);
+  parts.push_back (this);
+  for (std::vector<Buffer>::const_iterator i = buffers.begin (); i != buffers.end (); ++i)
+    {
+      parts.push_back (&*i);
+    }
+
+  /**
+   * Find the longest run of zero bytes which can stay virtual: the
+   * zero area of a buffer, followed by the zero areas of the next
+   * buffers, as long as they are adjacent.
+   */
+  uint32_t first = 0;
+  uint32_t last = 0;
+  uint32_t zeroSize = 0;
+  for (uint32_t k = 0; k < parts.size (); )
+    {
+      uint32_t size = parts[k]->m_zeroAreaEnd - parts[k]->m_zeroAreaStart;
+      uint32_t l = k;
+      while (l + 1 < parts.size () &&
+             parts[l]->m_end == parts[l]->m_zeroAreaEnd &&
+             parts[l + 1]->m_start == parts[l + 1]->m_zeroAreaStart)
+        {
+          l++;
+          size += parts[l]->m_zeroAreaEnd - parts[l]->m_zeroAreaStart;
+        }
+      if (size > zeroSize)
+        {
+          first = k;
+          last = l;
+          zeroSize = size;
+        }
+      k = l + 1;
+    }
 
-  dst.AddAtEnd (src.GetSize ());
-  Buffer::Iterator destStart = dst.End ();
-  destStart.Prev (src.GetSize ());
-  destStart.Write (src.Begin (), src.End ());
+  // write the bytes around the run in a single new buffer
+  const Buffer *a = parts[first];
+  const Buffer *b = parts[last];
+  uint32_t startData = a->m_zeroAreaStart - a->m_start;
+  uint32_t endData = b->m_end - b->m_zeroAreaEnd;
+  uint32_t before = startData;
+  for (uint32_t k = 0; k < first; k++)
+    {
+      before += parts[k]->GetSize ();
+    }
+  uint32_t after = endData;
+  for (uint32_t k = last + 1; k < parts.size (); k++)
+    {
+      after += parts[k]->GetSize ();
+    }
+  Buffer dst (zeroSize);
+  dst.AddAtStart (before);
+  Buffer::Iterator i = dst.Begin ();
+  for (uint32_t k = 0; k < first; k++)
+    {
+      i.Write (parts[k]->Begin (), parts[k]->End ());
+    }
+  i.Write (a->m_data->m_data + a->m_start, startData);
+  dst.AddAtEnd (after);
+  i = dst.End ();
+  i.Prev (after);
+  i.Write (b->m_data->m_data + b->m_zeroAreaStart, endData);
+  for (uint32_t k = last + 1; k < parts.size (); k++)
+    {
+      i.Write (parts[k]->Begin (), parts[k]->End ());
+    }
   *this = dst;
   NS_ASSERT (CheckInternalState ());
 }
@@ -754,14 +844,8 @@ Buffer::CopyData (uint8_t *buffer, uint32_t size) const
       if (size > 0) 
         { 
           tmpsize = std::min (m_zeroAreaEnd - m_zeroAreaStart, size);
-          uint32_t left = tmpsize;
-          while (left > 0)
-            {
-              uint32_t toWrite = std::min (left, g_zeroes.size);
-              memcpy (buffer, g_zeroes.buffer, toWrite);
-              left -= toWrite;
-              buffer += toWrite;
-            }
+          memset (buffer, 0, tmpsize);
+          buffer += tmpsize;
           size -= tmpsize;
           if (size > 0)
             {
@@ -843,27 +927,36 @@ Buffer::Iterator::Write (Iterator start, Iterator end)
   uint32_t size = end.m_current - start.m_current;
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
+  // the written bytes are either all before or all after our zero area
+  uint8_t *to;
+  if (m_current <= m_zeroStart)
+    {
+      to = &m_data[m_current];
+    }
+  else
+    {
+      to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
+  m_current += size;
   if (start.m_current <= start.m_zeroStart)
     {
       uint32_t toCopy = std::min (size, start.m_zeroStart - start.m_current);
-      memcpy (&m_data[m_current], &start.m_data[start.m_current], toCopy);
+      memcpy (to, &start.m_data[start.m_current], toCopy);
       start.m_current += toCopy;
-      m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   if (start.m_current <= start.m_zeroEnd)
     {
       uint32_t toCopy = std::min (size, start.m_zeroEnd - start.m_current);
-      memset (&m_data[m_current], 0, toCopy);
+      memset (to, 0, toCopy);
       start.m_current += toCopy;
-      m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   uint32_t toCopy = std::min (size, start.m_dataEnd - start.m_current);
   uint8_t *from = &start.m_data[start.m_current - (start.m_zeroEnd-start.m_zeroStart)];
-  uint8_t *to = &m_data[m_current];
   memcpy (to, from, toCopy);
-  m_current += toCopy;
 }
 
 void 
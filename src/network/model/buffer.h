@@ -24,6 +24,7 @@
 #include <vector>
 #include <ostream>
 #include "ns3/assert.h"
+#include "data-cache.h"
 
 #define BUFFER_FREE_LIST 1
 
@@ -65,10 +66,15 @@ namespace ns3 {
  * contains real data bytes in its BufferData instance but it also
  * contains "virtual zero data" which typically is used to represent
  * application-level payload. No memory is allocated to store the
- * zero bytes of application-level payload unless the user fragments
- * a Buffer: this application-level payload is kept track of with
- * a pair of integers which describe where in the buffer content
- * the "virtual zero area" starts and ends.
+ * zero bytes of application-level payload: this application-level
+ * payload is kept track of with a pair of integers which describe
+ * where in the buffer content the "virtual zero area" starts and ends.
+ * The zero area survives copies, fragments, headers and trailers;
+ * only PeekData () turns it into real bytes, and the copies made with
+ * CopyData () write the zeros without storing them.  When two Buffers
+ * are concatenated with AddAtEnd (const Buffer &), adjacent zero areas
+ * are merged; otherwise the larger zero area is kept and only the
+ * bytes of the smaller one are written.
  *
  * \verbatim
  * ***: unused bytes
@@ -518,11 +524,24 @@ private:
   /**
    * \param o the buffer to append to the end of this buffer.
    *
-   * Add bytes at the end of the Buffer.
+   * Add bytes at the end of the Buffer. The virtual zero areas of
+   * the two buffers are merged if they are adjacent; otherwise, the
+   * larger one stays virtual.
    * Any call to this method invalidates any Iterator
    * pointing to this Buffer.
    */
   void AddAtEnd (const Buffer &o);
+  /**
+   * \param buffers the buffers to append to the end of this buffer,
+   *        in order.
+   *
+   * Add bytes at the end of the Buffer, with a single copy of the bytes
+   * of all the buffers.  The longest run of adjacent virtual zero areas
+   * stays virtual; the other zero areas are written.
+   * Any call to this method invalidates any Iterator
+   * pointing to this Buffer.
+   */
+  void AddAtEnd (const std::vector<Buffer> &buffers);
   /**
    * \param start size to remove
    *
@@ -636,6 +655,15 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * Get the statistics of the cache which recycles the memory of
+   * the buffers.
+   *
+   * 
+eturns The statistics, summed over all threads.
+   */
+  static DataCache::Stats GetCacheStats (void);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -784,18 +812,6 @@ private:
    */
   uint32_t m_end;
 
-#ifdef BUFFER_FREE_LIST
-  /// Container for buffer data
-  typedef std::vector<struct Buffer::Data*> FreeList;
-  /// Local static destructor structure
-  struct LocalStaticDestructor 
-  {
-    ~LocalStaticDestructor ();
-  };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
@@ -0,0 +1,375 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-config.h"
+#include "data-cache.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <vector>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DataCache");
+
+namespace {
+
+/** A cached block. */
+struct Entry
+{
+  uint8_t *block;  //!< The block
+  uint32_t size;   //!< The size of the block
+};
+
+/**
+ * Add the counters of a Stats to another one.
+ *
+ * \param [in,out] sum The sum.
+ * \param [in] stats The counters to add.
+ */
+void
+Add (DataCache::Stats &sum, const DataCache::Stats &stats)
+{
+  sum.requests += stats.requests;
+  sum.hits += stats.hits;
+  sum.releases += stats.releases;
+  sum.discarded += stats.discarded;
+  sum.toDepot += stats.toDepot;
+  sum.fromDepot += stats.fromDepot;
+  for (uint32_t i = 0; i < DataCache::SIZE_BUCKETS; i++)
+    {
+      sum.sizes[i] += stats.sizes[i];
+    }
+}
+
+} // anonymous namespace
+
+/** The free list and the statistics of a thread. */
+struct DataCache::Local
+{
+  DataCache *cache;   //!< The cache of this free list
+  Entry *entries;     //!< The cached blocks, the most recent last
+  uint32_t n;         //!< The number of cached blocks
+  uint32_t maxSize;   //!< The size of the largest block released by this thread
+  Stats stats;        //!< Statistics of this thread
+  Local *next;        //!< Next free list of the cache
+};
+
+/** The state of a cache shared by all the threads. */
+struct DataCache::Shared
+{
+  uint32_t capacity;            //!< The capacity of each free list
+  uint32_t depotCapacity;       //!< The capacity of the depot
+  std::vector<Entry> depot;     //!< The blocks shared by all the threads
+  Local *locals;                //!< The free lists of the running threads
+  Stats retired;                //!< Statistics of the threads which exited
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_t mutex;        //!< Protects the depot, locals and retired
+  pthread_key_t key;            //!< The free list of the current thread
+#endif /* HAVE_PTHREAD_H */
+};
+
+DataCache::Stats::Stats ()
+  : requests (0),
+    hits (0),
+    releases (0),
+    discarded (0),
+    toDepot (0),
+    fromDepot (0)
+{
+  for (uint32_t i = 0; i < SIZE_BUCKETS; i++)
+    {
+      sizes[i] = 0;
+    }
+}
+
+double
+DataCache::Stats::GetHitRate (void) const
+{
+  return requests > 0 ? static_cast<double> (hits) / requests : 0.0;
+}
+
+DataCache::DataCache (uint32_t capacity, uint32_t depotCapacity)
+{
+  NS_LOG_FUNCTION (this << capacity << depotCapacity);
+  Shared *shared = new Shared ();
+  shared->capacity = std::max (capacity, 2U);
+  shared->depotCapacity = depotCapacity;
+  shared->locals = 0;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_init (&shared->mutex, 0);
+  pthread_key_create (&shared->key, &DataCache::ReleaseLocal);
+#endif /* HAVE_PTHREAD_H */
+  m_shared = shared;
+}
+
+DataCache::~DataCache ()
+{
+  NS_LOG_FUNCTION (this);
+  Shared *shared = m_shared;
+  // from now on, Get and Put leave the blocks to their callers
+  m_shared = 0;
+#ifdef HAVE_PTHREAD_H
+  pthread_key_delete (shared->key);
+  pthread_mutex_destroy (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  while (shared->locals != 0)
+    {
+      Local *local = shared->locals;
+      shared->locals = local->next;
+      for (uint32_t i = 0; i < local->n; i++)
+        {
+          delete [] local->entries[i].block;
+        }
+      delete [] local->entries;
+      delete local;
+    }
+  for (std::vector<Entry>::iterator i = shared->depot.begin (); i != shared->depot.end (); ++i)
+    {
+      delete [] i->block;
+    }
+  delete shared;
+}
+
+DataCache::Local *
+DataCache::GetLocal (void)
+{
+  Shared *shared = m_shared;
+  if (shared == 0)
+    {
+      return 0;
+    }
+#ifdef HAVE_PTHREAD_H
+  Local *local = static_cast<Local *> (pthread_getspecific (shared->key));
+#else /* HAVE_PTHREAD_H */
+  Local *local = shared->locals;
+#endif /* HAVE_PTHREAD_H */
+  if (local != 0)
+    {
+      return local;
+    }
+  local = new Local ();
+  local->cache = this;
+  local->entries = new Entry [shared->capacity];
+  local->n = 0;
+  local->maxSize = 0;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&shared->mutex);
+  local->next = shared->locals;
+  shared->locals = local;
+  pthread_mutex_unlock (&shared->mutex);
+  pthread_setspecific (shared->key, local);
+#else /* HAVE_PTHREAD_H */
+  local->next = 0;
+  shared->locals = local;
+#endif /* HAVE_PTHREAD_H */
+  return local;
+}
+
+uint8_t *
+DataCache::Get (uint32_t size)
+{
+  Local *local = GetLocal ();
+  if (local == 0)
+    {
+      return 0;
+    }
+  local->stats.requests++;
+  uint32_t bucket = 0;
+  while (bucket < SIZE_BUCKETS - 1 && (size >> (bucket + 1)) != 0)
+    {
+      bucket++;
+    }
+  local->stats.sizes[bucket]++;
+  if (local->n == 0)
+    {
+      Refill (local);
+    }
+  while (local->n > 0)
+    {
+      Entry entry = local->entries[--local->n];
+      if (entry.size >= size)
+        {
+          local->stats.hits++;
+          return entry.block;
+        }
+      delete [] entry.block;
+      local->stats.discarded++;
+    }
+  return 0;
+}
+
+bool
+DataCache::Put (uint8_t *block, uint32_t size)
+{
+  Local *local = GetLocal ();
+  if (local == 0)
+    {
+      return false;
+    }
+  local->stats.releases++;
+  local->maxSize = std::max (local->maxSize, size);
+  if (size < local->maxSize)
+    {
+      local->stats.discarded++;
+      return false;
+    }
+  if (local->n == m_shared->capacity)
+    {
+      Flush (local);
+    }
+  local->entries[local->n].block = block;
+  local->entries[local->n].size = size;
+  local->n++;
+  return true;
+}
+
+void
+DataCache::Flush (Local *local)
+{
+  NS_LOG_FUNCTION (this << local);
+  Shared *shared = m_shared;
+  // the oldest blocks go to the depot
+  uint32_t count = local->n / 2;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  uint32_t room = 0;
+  if (shared->depot.size () < shared->depotCapacity)
+    {
+      room = shared->depotCapacity - shared->depot.size ();
+    }
+  uint32_t kept = std::min (count, room);
+  shared->depot.insert (shared->depot.end (), local->entries, local->entries + kept);
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_unlock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  for (uint32_t i = kept; i < count; i++)
+    {
+      delete [] local->entries[i].block;
+    }
+  std::copy (local->entries + count, local->entries + local->n, local->entries);
+  local->n -= count;
+  local->stats.toDepot += kept;
+  local->stats.discarded += count - kept;
+}
+
+void
+DataCache::Refill (Local *local)
+{
+  Shared *shared = m_shared;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  uint32_t count = std::min<uint32_t> (shared->capacity / 2, shared->depot.size ());
+  std::copy (shared->depot.end () - count, shared->depot.end (), local->entries);
+  shared->depot.resize (shared->depot.size () - count);
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_unlock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  local->n = count;
+  local->stats.fromDepot += count;
+}
+
+void
+DataCache::Release (Local *local)
+{
+  NS_LOG_FUNCTION (this << local);
+  Shared *shared = m_shared;
+  uint32_t kept = 0;
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  for (uint32_t i = 0; i < local->n; i++)
+    {
+      if (shared->depot.size () < shared->depotCapacity)
+        {
+          shared->depot.push_back (local->entries[i]);
+          kept++;
+        }
+      else
+        {
+          delete [] local->entries[i].block;
+        }
+    }
+  local->stats.toDepot += kept;
+  local->stats.discarded += local->n - kept;
+  Add (shared->retired, local->stats);
+  for (Local **i = &shared->locals; *i != 0; i = &(*i)->next)
+    {
+      if (*i == local)
+        {
+          *i = local->next;
+          break;
+        }
+    }
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_unlock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  delete [] local->entries;
+  delete local;
+}
+
+void
+DataCache::ReleaseLocal (void *data)
+{
+  Local *local = static_cast<Local *> (data);
+  local->cache->Release (local);
+}
+
+DataCache::Stats
+DataCache::GetStats (void) const
+{
+  Stats stats;
+  Shared *shared = m_shared;
+  if (shared == 0)
+    {
+      return stats;
+    }
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  stats = shared->retired;
+  for (Local *local = shared->locals; local != 0; local = local->next)
+    {
+      Add (stats, local->stats);
+    }
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_unlock (&shared->mutex);
+#endif /* HAVE_PTHREAD_H */
+  return stats;
+}
+
+std::ostream &
+operator << (std::ostream &os, const DataCache::Stats &stats)
+{
+  os << "requests=" << stats.requests
+     << " hits=" << stats.hits
+     << " releases=" << stats.releases
+     << " discarded=" << stats.discarded
+     << " toDepot=" << stats.toDepot
+     << " fromDepot=" << stats.fromDepot
+     << " sizes=";
+  for (uint32_t i = 0; i < DataCache::SIZE_BUCKETS; i++)
+    {
+      os << (i > 0 ? "," : "") << stats.sizes[i];
+    }
+  return os;
+}
+
+} // namespace ns3
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DATA_CACHE_H
+#define DATA_CACHE_H
+
+#include <stdint.h>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ * \brief A cache of released memory blocks, with one free list per thread.
+ *
+ * Buffer and PacketMetadata recycle the memory of their data storage
+ * through a DataCache.  The blocks are allocated by the users of the
+ * cache with new uint8_t [], and have a size which is known to them:
+ * Put keeps a released block, or reports that it should be deallocated;
+ * Get returns a block of at least the requested size, or 0 if the cache
+ * cannot provide one.
+ *
+ * When threads are supported, each thread owns a bounded free list,
+ * so that Get and Put take no lock.  A free list which overflows
+ * moves half of its blocks to a depot shared by all the threads, also
+ * bounded, and an empty free list takes its blocks back from the depot.
+ * The blocks beyond both bounds are deallocated.  A released block
+ * which is smaller than the largest one released by the same thread
+ * is not kept either, since it would likely be too small for the next
+ * requests.
+ *
+ * A DataCache is meant to be a static object: it caches nothing before
+ * its constructor and after its destructor have run, so that the
+ * Buffer and PacketMetadata instances of other static objects can be
+ * created and destroyed at any time.
+ */
+class DataCache
+{
+public:
+  /** Number of buckets of the size distribution. */
+  static const uint32_t SIZE_BUCKETS = 16;
+
+  /** Cache statistics. */
+  struct Stats
+  {
+    /** Constructor: all counters are zero. */
+    Stats ();
+    /** Number of calls to Get. */
+    uint64_t requests;
+    /** Number of requests served by a cached block. */
+    uint64_t hits;
+    /** Number of calls to Put. */
+    uint64_t releases;
+    /**
+     * Number of blocks deallocated by the cache, or not kept by Put:
+     * too small, or beyond the bounds.
+     */
+    uint64_t discarded;
+    /** Number of blocks moved from the free lists to the depot. */
+    uint64_t toDepot;
+    /** Number of blocks moved from the depot to the free lists. */
+    uint64_t fromDepot;
+    /**
+     * Distribution of the requested sizes: sizes[i] counts the requests
+     * of less than 2^(i+1) bytes which do not fit in sizes[i-1]; the last
+     * bucket counts all the larger requests.
+     */
+    uint64_t sizes[SIZE_BUCKETS];
+
+    /** \returns The fraction of the requests served by a cached block. */
+    double GetHitRate (void) const;
+  };
+
+  /**
+   * Constructor.
+   *
+   * \param [in] capacity The maximum number of blocks in the free list
+   *             of each thread.
+   * \param [in] depotCapacity The maximum number of blocks in the depot.
+   */
+  DataCache (uint32_t capacity, uint32_t depotCapacity);
+  /**
+   * Destructor: deallocate the blocks of the free list of the current
+   * thread and of the depot.
+   */
+  ~DataCache ();
+
+  /**
+   * Get a cached block.
+   *
+   * \param [in] size The minimum size of the block.
+   * \returns A block of at least size bytes, or 0 if there is none.
+   */
+  uint8_t * Get (uint32_t size);
+  /**
+   * Release a block to the cache.
+   *
+   * \param [in] block The block, allocated with new uint8_t [].
+   * \param [in] size The size of the block.
+   * \returns true if the cache keeps the block, false if the caller
+   *          should deallocate it.
+   */
+  bool Put (uint8_t *block, uint32_t size);
+  /**
+   * Get the statistics of the cache, summed over all threads.
+   *
+   * The counters of the threads which are running are read without
+   * synchronization, so they may be slightly out of date.
+   *
+   * \returns The statistics.
+   */
+  Stats GetStats (void) const;
+
+private:
+  struct Local;
+  struct Shared;
+
+  /** \returns The free list of the current thread, or 0 if the cache is not usable. */
+  Local * GetLocal (void);
+  /**
+   * Move blocks from a full free list to the depot.
+   * \param [in,out] local The free list.
+   */
+  void Flush (Local *local);
+  /**
+   * Move blocks from the depot to an empty free list.
+   * \param [in,out] local The free list.
+   */
+  void Refill (Local *local);
+  /**
+   * Hand a free list and its statistics over to the depot, and delete it.
+   * Called when a thread exits.
+   * \param [in] local The free list.
+   */
+  void Release (Local *local);
+  /**
+   * The destructor of the thread-specific data.
+   * \param [in] data The free list of the exiting thread.
+   */
+  static void ReleaseLocal (void *data);
+
+  /**
+   * Copy constructor: not implemented.
+   * \param [in] o The cache.
+   */
+  DataCache (const DataCache &o);
+  /**
+   * Assignment: not implemented.
+   * \param [in] o The cache.
+   * \returns This cache.
+   */
+  DataCache & operator = (const DataCache &o);
+
+  /**
+   * The state shared by all the threads, or 0 before the constructor
+   * and after the destructor.
+   */
+  Shared *m_shared;
+};
+
+/**
+ * \ingroup packet
+ * Output streamer for DataCache::Stats.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] stats The statistics.
+ * \returns The stream.
+ */
+std::ostream & operator << (std::ostream &os, const DataCache::Stats &stats);
+
+} // namespace ns3
+
+#endif /* DATA_CACHE_H */
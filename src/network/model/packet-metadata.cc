@@ -19,6 +19,7 @@
  */
 #include <utility>
 #include <list>
+#include <algorithm>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -36,17 +37,16 @@ bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
+bool PacketMetadata::m_compact = false;
+struct PacketMetadata::Node **PacketMetadata::m_nodes = 0;
+uint32_t PacketMetadata::m_nBuckets = 0;
+uint32_t PacketMetadata::m_nNodes = 0;
+/**
+ * The free lists of the PacketMetadata::Data instances.  The metadata
+ * created or destroyed by the static constructors or destructors which
+ * run before or after those of this compilation unit bypass it.
+ */
+static DataCache g_cache (1000, 4000);
 
 void 
 PacketMetadata::Enable (void)
@@ -70,6 +70,233 @@ PacketMetadata::EnableChecking (void)
   m_enableChecking = true;
 }
 
+void
+PacketMetadata::SetCompact (bool compact)
+{
+  NS_LOG_FUNCTION (compact);
+  m_compact = compact;
+}
+
+uint32_t
+PacketMetadata::GetNCompactNodes (void)
+{
+  return m_nNodes;
+}
+
+DataCache::Stats
+PacketMetadata::GetCacheStats (void)
+{
+  return g_cache.GetStats ();
+}
+
+PacketMetadata::PacketMetadata (uint64_t uid)
+  : m_data (PacketMetadata::Create (10)),
+    m_node (0),
+    m_head (0xffff),
+    m_tail (0xffff),
+    m_used (0),
+    m_packetUid (uid)
+{
+  memset (m_data->m_data, 0xff, 4);
+}
+
+struct PacketMetadata::Node *
+PacketMetadata::LookupNode (const struct PacketMetadata::Node &item)
+{
+  NS_LOG_FUNCTION (item.uid << item.size << item.fragmentStart << item.fragmentEnd <<
+                   item.packetUid << item.isOwn << item.next);
+  uint64_t h = item.uid;
+  h = h * 1000003 ^ item.size;
+  h = h * 1000003 ^ item.fragmentStart;
+  h = h * 1000003 ^ item.fragmentEnd;
+  h = h * 1000003 ^ item.chunkUid;
+  h = h * 1000003 ^ item.packetUid;
+  h = h * 1000003 ^ item.isOwn;
+  h = h * 1000003 ^ reinterpret_cast<uintptr_t> (item.next);
+  uint32_t hash = h ^ (h >> 32);
+  if (m_nBuckets != 0)
+    {
+      for (struct Node *node = m_nodes[hash & (m_nBuckets - 1)];
+           node != 0; node = node->chain)
+        {
+          if (node->hash == hash &&
+              node->uid == item.uid &&
+              node->size == item.size &&
+              node->fragmentStart == item.fragmentStart &&
+              node->fragmentEnd == item.fragmentEnd &&
+              node->chunkUid == item.chunkUid &&
+              node->packetUid == item.packetUid &&
+              node->isOwn == item.isOwn &&
+              node->next == item.next)
+            {
+              node->count++;
+              return node;
+            }
+        }
+    }
+  if (m_nNodes >= m_nBuckets)
+    {
+      // keep at most one node per bucket on average
+      uint32_t nBuckets = std::max<uint32_t> (64, m_nBuckets * 2);
+      struct Node **nodes = new struct Node *[nBuckets];
+      std::fill (nodes, nodes + nBuckets, static_cast<struct Node *> (0));
+      for (uint32_t i = 0; i < m_nBuckets; i++)
+        {
+          struct Node *node = m_nodes[i];
+          while (node != 0)
+            {
+              struct Node *chain = node->chain;
+              node->chain = nodes[node->hash & (nBuckets - 1)];
+              nodes[node->hash & (nBuckets - 1)] = node;
+              node = chain;
+            }
+        }
+      delete [] m_nodes;
+      m_nodes = nodes;
+      m_nBuckets = nBuckets;
+    }
+  struct Node *node = new struct Node (item);
+  node->count = 1;
+  node->hash = hash;
+  node->maxChunkUid = node->chunkUid;
+  if (node->next != 0)
+    {
+      node->next->count++;
+      node->maxChunkUid = std::max (node->maxChunkUid, node->next->maxChunkUid);
+    }
+  node->chain = m_nodes[hash & (m_nBuckets - 1)];
+  m_nodes[hash & (m_nBuckets - 1)] = node;
+  m_nNodes++;
+  return node;
+}
+
+void
+PacketMetadata::ReleaseNode (struct PacketMetadata::Node *node)
+{
+  NS_LOG_FUNCTION (node);
+  while (node != 0)
+    {
+      NS_ASSERT (node->count > 0);
+      node->count--;
+      if (node->count > 0)
+        {
+          return;
+        }
+      struct Node **i = &m_nodes[node->hash & (m_nBuckets - 1)];
+      while (*i != node)
+        {
+          i = &(*i)->chain;
+        }
+      *i = node->chain;
+      m_nNodes--;
+      struct Node *next = node->next;
+      delete node;
+      node = next;
+    }
+  if (m_nNodes == 0)
+    {
+      // do not keep the table around once all the packets are gone
+      delete [] m_nodes;
+      m_nodes = 0;
+      m_nBuckets = 0;
+    }
+}
+
+void
+PacketMetadata::SetHead (struct PacketMetadata::Node *head)
+{
+  NS_LOG_FUNCTION (this << head);
+  ReleaseNode (m_node);
+  m_node = head;
+}
+
+void
+PacketMetadata::GetItems (std::vector<struct PacketMetadata::Node> &items) const
+{
+  NS_LOG_FUNCTION (this);
+  items.clear ();
+  if (m_data == 0)
+    {
+      for (const struct Node *node = m_node; node != 0; node = node->next)
+        {
+          items.push_back (*node);
+          if (node->isOwn)
+            {
+              items.back ().packetUid = m_packetUid;
+            }
+        }
+      return;
+    }
+  uint16_t current = m_head;
+  while (current != 0xffff)
+    {
+      struct PacketMetadata::SmallItem item;
+      struct PacketMetadata::ExtraItem extraItem;
+      ReadItems (current, &item, &extraItem);
+      struct PacketMetadata::Node node;
+      node.uid = item.typeUid >> 1;
+      node.size = item.size;
+      node.fragmentStart = extraItem.fragmentStart;
+      node.fragmentEnd = extraItem.fragmentEnd;
+      node.chunkUid = item.chunkUid;
+      node.maxChunkUid = item.chunkUid;
+      node.packetUid = extraItem.packetUid;
+      node.isOwn = false;
+      node.next = 0;
+      items.push_back (node);
+      if (current == m_tail)
+        {
+          break;
+        }
+      current = item.next;
+    }
+}
+
+void
+PacketMetadata::SetItems (const std::vector<struct PacketMetadata::Node> &items)
+{
+  NS_LOG_FUNCTION (this << items.size ());
+  if (m_data == 0)
+    {
+      // the list is built from its tail
+      struct Node *head = 0;
+      for (std::vector<struct Node>::const_reverse_iterator i = items.rbegin ();
+           i != items.rend (); i++)
+        {
+          struct Node item = *i;
+          item.isOwn = item.packetUid == m_packetUid;
+          if (item.isOwn)
+            {
+              item.packetUid = 0;
+            }
+          item.next = head;
+          struct Node *node = LookupNode (item);
+          ReleaseNode (head);
+          head = node;
+        }
+      SetHead (head);
+      return;
+    }
+  PacketMetadata h (m_packetUid);
+  for (std::vector<struct Node>::const_iterator i = items.begin ();
+       i != items.end (); i++)
+    {
+      struct PacketMetadata::SmallItem item;
+      struct PacketMetadata::ExtraItem extraItem;
+      item.next = 0xffff;
+      item.prev = h.m_tail;
+      item.typeUid = (i->uid << 1) | 0x1;
+      item.size = i->size;
+      item.chunkUid = i->chunkUid;
+      extraItem.fragmentStart = i->fragmentStart;
+      extraItem.fragmentEnd = i->fragmentEnd;
+      extraItem.packetUid = i->packetUid;
+      uint16_t written = h.AddBig (0xffff, h.m_tail, &item, &extraItem);
+      h.UpdateTail (written);
+    }
+  *this = h;
+}
+
 void
 PacketMetadata::ReserveCopy (uint32_t size)
 {
@@ -133,6 +360,11 @@ bool
 PacketMetadata::IsStateOk (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_data == 0)
+    {
+      // the nodes of the compact representation are immutable
+      return true;
+    }
   bool ok = m_used <= m_data->m_size;
   ok &= IsPointerOk (m_head);
   ok &= IsPointerOk (m_tail);
@@ -505,7 +737,7 @@ PacketMetadata::ReplaceTail (PacketMetadata::SmallItem *item,
    */
 
   // create a copy of the packet without its tail.
-  PacketMetadata h (m_packetUid, 0);
+  PacketMetadata h (m_packetUid);
   uint16_t current = m_head;
   while (current != 0xffff && current != m_tail)
     {
@@ -576,18 +808,13 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  uint8_t *block = g_cache.Get (size);
+  if (block != 0)
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
-        {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
-        }
-      PacketMetadata::Deallocate (data);
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
+      struct PacketMetadata::Data *data = reinterpret_cast<struct PacketMetadata::Data *> (block);
+      NS_LOG_LOGIC ("create found size="<<data->m_size);
+      data->m_count = 1;
+      return data;
     }
   NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
   return PacketMetadata::Allocate (m_maxSize);
@@ -602,16 +829,12 @@ PacketMetadata::Recycle (struct PacketMetadata::Data *data)
       PacketMetadata::Deallocate (data);
       return;
     } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
+  NS_LOG_LOGIC ("recycle size="<<data->m_size);
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
+  if (data->m_size < m_maxSize ||
+      !g_cache.Put (reinterpret_cast<uint8_t *> (data), data->m_size))
     {
       PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
     }
 }
 
@@ -669,6 +892,20 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      struct PacketMetadata::Node item;
+      item.uid = uid >> 1;
+      item.size = size;
+      item.fragmentStart = 0;
+      item.fragmentEnd = size;
+      item.chunkUid = m_node != 0 ? m_node->maxChunkUid + 1 : 0;
+      item.packetUid = 0;
+      item.isOwn = true;
+      item.next = m_node;
+      SetHead (LookupNode (item));
+      return;
+    }
 
   struct PacketMetadata::SmallItem item;
   item.next = m_head;
@@ -691,6 +928,34 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      if (m_node == 0 ||
+          m_node->uid != uid >> 1 ||
+          m_node->size != size)
+        {
+          if (m_enableChecking)
+            {
+              NS_FATAL_ERROR ("Removing unexpected header.");
+            }
+          return;
+        }
+      else if (m_node->fragmentStart != 0 ||
+               m_node->fragmentEnd != size)
+        {
+          if (m_enableChecking)
+            {
+              NS_FATAL_ERROR ("Removing incomplete header.");
+            }
+          return;
+        }
+      if (m_node->next != 0)
+        {
+          m_node->next->count++;
+        }
+      SetHead (m_node->next);
+      return;
+    }
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_head, &item, &extraItem);
@@ -739,6 +1004,26 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      std::vector<struct PacketMetadata::Node> items;
+      GetItems (items);
+      struct PacketMetadata::Node item;
+      item.uid = uid >> 1;
+      item.size = size;
+      item.fragmentStart = 0;
+      item.fragmentEnd = size;
+      item.chunkUid = 0;
+      for (std::vector<struct PacketMetadata::Node>::const_iterator i = items.begin ();
+           i != items.end (); i++)
+        {
+          item.chunkUid = std::max<uint16_t> (item.chunkUid, i->chunkUid + 1);
+        }
+      item.packetUid = m_packetUid;
+      items.push_back (item);
+      SetItems (items);
+      return;
+    }
   struct PacketMetadata::SmallItem item;
   item.next = 0xffff;
   item.prev = m_tail;
@@ -761,6 +1046,33 @@ PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      std::vector<struct PacketMetadata::Node> items;
+      GetItems (items);
+      if (items.empty () ||
+          items.back ().uid != uid >> 1 ||
+          items.back ().size != size)
+        {
+          if (m_enableChecking)
+            {
+              NS_FATAL_ERROR ("Removing unexpected trailer.");
+            }
+          return;
+        }
+      else if (items.back ().fragmentStart != 0 ||
+               items.back ().fragmentEnd != size)
+        {
+          if (m_enableChecking)
+            {
+              NS_FATAL_ERROR ("Removing incomplete trailer.");
+            }
+          return;
+        }
+      items.pop_back ();
+      SetItems (items);
+      return;
+    }
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_tail, &item, &extraItem);
@@ -808,7 +1120,7 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
       m_metadataSkipped = true;
       return;
     }
-  if (m_tail == 0xffff)
+  if (m_tail == 0xffff && m_node == 0)
     {
       // We have no items so 'AddAtEnd' is 
       // equivalent to self-assignment.
@@ -816,6 +1128,33 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
       NS_ASSERT (IsStateOk ());
       return;
     }
+  if (m_data == 0 || o.m_data == 0)
+    {
+      // At least one of the lists is in the compact representation:
+      // merge the items in the same way as below.
+      std::vector<struct PacketMetadata::Node> items;
+      std::vector<struct PacketMetadata::Node> others;
+      GetItems (items);
+      o.GetItems (others);
+      if (others.empty ())
+        {
+          return;
+        }
+      struct PacketMetadata::Node &tail = items.back ();
+      const struct PacketMetadata::Node &head = others.front ();
+      if (head.packetUid == tail.packetUid &&
+          head.uid == tail.uid &&
+          head.size == tail.size &&
+          head.chunkUid == tail.chunkUid &&
+          head.fragmentStart == tail.fragmentEnd)
+        {
+          tail.fragmentEnd = head.fragmentEnd;
+          others.erase (others.begin ());
+        }
+      items.insert (items.end (), others.begin (), others.end ());
+      SetItems (items);
+      return;
+    }
   if (o.m_head == 0xffff)
     {
       NS_ASSERT (o.m_tail == 0xffff);
@@ -896,6 +1235,32 @@ PacketMetadata::RemoveAtStart (uint32_t start)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      uint32_t leftToRemove = start;
+      struct PacketMetadata::Node *current = m_node;
+      while (current != 0 && leftToRemove > 0)
+        {
+          uint32_t itemRealSize = current->fragmentEnd - current->fragmentStart;
+          if (itemRealSize > leftToRemove)
+            {
+              // fragment the list item.
+              struct PacketMetadata::Node item = *current;
+              item.fragmentStart += leftToRemove;
+              SetHead (LookupNode (item));
+              return;
+            }
+          leftToRemove -= itemRealSize;
+          current = current->next;
+        }
+      NS_ASSERT (leftToRemove == 0);
+      if (current != 0)
+        {
+          current->count++;
+        }
+      SetHead (current);
+      return;
+    }
   NS_ASSERT (m_data != 0);
   uint32_t leftToRemove = start;
   uint16_t current = m_head;
@@ -922,7 +1287,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
       else
         {
           // fragment the list item.
-          PacketMetadata fragment (m_packetUid, 0);
+          PacketMetadata fragment (m_packetUid);
           extraItem.fragmentStart += leftToRemove;
           leftToRemove = 0;
           uint16_t written = fragment.AddBig (0xffff, fragment.m_tail,
@@ -959,6 +1324,29 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
       m_metadataSkipped = true;
       return;
     }
+  if (m_data == 0)
+    {
+      std::vector<struct PacketMetadata::Node> items;
+      GetItems (items);
+      uint32_t leftToRemove = end;
+      while (!items.empty () && leftToRemove > 0)
+        {
+          struct PacketMetadata::Node &item = items.back ();
+          uint32_t itemRealSize = item.fragmentEnd - item.fragmentStart;
+          if (itemRealSize > leftToRemove)
+            {
+              // fragment the list item.
+              item.fragmentEnd -= leftToRemove;
+              leftToRemove = 0;
+              break;
+            }
+          leftToRemove -= itemRealSize;
+          items.pop_back ();
+        }
+      NS_ASSERT (leftToRemove == 0);
+      SetItems (items);
+      return;
+    }
   NS_ASSERT (m_data != 0);
 
   uint32_t leftToRemove = end;
@@ -986,7 +1374,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
       else
         {
           // fragment the list item.
-          PacketMetadata fragment (m_packetUid, 0);
+          PacketMetadata fragment (m_packetUid);
           NS_ASSERT (extraItem.fragmentEnd > leftToRemove);
           extraItem.fragmentEnd -= leftToRemove;
           leftToRemove = 0;
@@ -1019,6 +1407,10 @@ PacketMetadata::GetTotalSize (void) const
 {
   NS_LOG_FUNCTION (this);
   uint32_t totalSize = 0;
+  for (const struct Node *node = m_node; node != 0; node = node->next)
+    {
+      totalSize += node->fragmentEnd - node->fragmentStart;
+    }
   uint16_t current = m_head;
   uint16_t tail = m_tail;
   while (current != 0xffff)
@@ -1052,6 +1444,7 @@ PacketMetadata::BeginItem (Buffer buffer) const
 PacketMetadata::ItemIterator::ItemIterator (const PacketMetadata *metadata, Buffer buffer)
   : m_metadata (metadata),
     m_buffer (buffer),
+    m_node (metadata->m_node),
     m_current (metadata->m_head),
     m_offset (0),
     m_hasReadTail (false)
@@ -1062,6 +1455,10 @@ bool
 PacketMetadata::ItemIterator::HasNext (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_metadata->m_data == 0)
+    {
+      return m_node != 0;
+    }
   if (m_current == 0xffff)
     {
       return false;
@@ -1079,12 +1476,23 @@ PacketMetadata::ItemIterator::Next (void)
   struct PacketMetadata::Item item;
   struct PacketMetadata::SmallItem smallItem;
   struct PacketMetadata::ExtraItem extraItem;
-  m_metadata->ReadItems (m_current, &smallItem, &extraItem);
-  if (m_current == m_metadata->m_tail)
+  if (m_metadata->m_data == 0)
     {
-      m_hasReadTail = true;
+      smallItem.typeUid = m_node->uid << 1;
+      smallItem.size = m_node->size;
+      extraItem.fragmentStart = m_node->fragmentStart;
+      extraItem.fragmentEnd = m_node->fragmentEnd;
+      m_node = m_node->next;
+    }
+  else
+    {
+      m_metadata->ReadItems (m_current, &smallItem, &extraItem);
+      if (m_current == m_metadata->m_tail)
+        {
+          m_hasReadTail = true;
+        }
+      m_current = smallItem.next;
     }
-  m_current = smallItem.next;
   uint32_t uid = (smallItem.typeUid & 0xfffffffe) >> 1;
   item.tid.SetUid (uid);
   item.currentTrimedFromStart = extraItem.fragmentStart;
@@ -1150,6 +1558,15 @@ PacketMetadata::GetSerializedSize (void) const
     {
       return totalSize;
     }
+  if (m_data == 0)
+    {
+      // serialize the default representation of the same items
+      std::vector<struct PacketMetadata::Node> items;
+      GetItems (items);
+      PacketMetadata h (m_packetUid);
+      h.SetItems (items);
+      return h.GetSerializedSize ();
+    }
 
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
@@ -1183,6 +1600,14 @@ uint32_t
 PacketMetadata::Serialize (uint8_t* buffer, uint32_t maxSize) const
 {
   NS_LOG_FUNCTION (this << &buffer << maxSize);
+  if (m_data == 0)
+    {
+      std::vector<struct PacketMetadata::Node> items;
+      GetItems (items);
+      PacketMetadata h (m_packetUid);
+      h.SetItems (items);
+      return h.Serialize (buffer, maxSize);
+    }
   uint8_t* start = buffer;
 
   buffer = AddToRawU64 (m_packetUid, start, buffer, maxSize);
@@ -1284,6 +1709,17 @@ uint32_t
 PacketMetadata::Deserialize (const uint8_t* buffer, uint32_t size)
 {
   NS_LOG_FUNCTION (this << &buffer << size);
+  if (m_data == 0)
+    {
+      // deserialize the default representation, then convert it
+      PacketMetadata h (0);
+      uint32_t ok = h.Deserialize (buffer, size);
+      std::vector<struct PacketMetadata::Node> items;
+      h.GetItems (items);
+      m_packetUid = h.m_packetUid;
+      SetItems (items);
+      return ok;
+    }
   const uint8_t* start = buffer;
   uint32_t desSize = size - 4;
 
@@ -27,6 +27,7 @@
 #include "ns3/assert.h"
 #include "ns3/type-id.h"
 #include "buffer.h"
+#include "data-cache.h"
 
 namespace ns3 {
 
@@ -74,9 +75,27 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * When the compact representation is selected with SetCompact, the
+ * metadata created from then on store their items in a list of
+ * immutable nodes instead, each of which identifies the next item of
+ * the list. These nodes are shared by all the packets: a node is
+ * created only once for a given item followed by a given list, so that
+ * the packets which carry the same stack of headers over a payload
+ * of the same size (for instance, the segments of a TCP connection)
+ * share all their nodes, and a copy of the metadata costs a single
+ * pointer. The packet uid of an item is stored only if it differs
+ * from that of the packet, and the chunk uid of an item is numbered
+ * within its list rather than globally. Adding or removing
+ * a header, or removing bytes at the start, takes a time proportional
+ * to the number of nodes involved; the other operations rebuild the
+ * list. The nodes are not protected against concurrent accesses, like
+ * the other data shared by the packets.
  */
 class PacketMetadata 
 {
+  struct Node;
+
 public:
 
   /**
@@ -146,6 +165,7 @@ public:
 private:
     const PacketMetadata *m_metadata; //!< pointer to the metadata
     Buffer m_buffer; //!< buffer the metadata refers to
+    const struct Node *m_node; //!< current node, in the compact representation
     uint16_t m_current; //!< current position
     uint32_t m_offset; //!< offset
     bool m_hasReadTail; //!< true if the metadata tail has been read
@@ -159,6 +179,29 @@ private:
    * \brief Enable the packet metadata checking
    */
   static void EnableChecking (void);
+  /**
+   * \brief Select the representation of the metadata created from now on
+   *
+   * The metadata which already exist keep their representation, and
+   * can be combined with those which use the other one.
+   *
+   * \param compact true for the compact representation, false for the
+   *        default one
+   */
+  static void SetCompact (bool compact);
+  /**
+   * \brief Get the number of nodes of the compact representation
+   *
+   * \returns the number of nodes shared by the existing metadata
+   */
+  static uint32_t GetNCompactNodes (void);
+  /**
+   * Get the statistics of the cache which recycles the memory of
+   * the metadata.
+   *
+   * \returns The statistics, summed over all threads.
+   */
+  static DataCache::Stats GetCacheStats (void);
 
   /**
    * \brief Constructor
@@ -492,18 +535,52 @@ private:
   };
 
   /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
+   * \brief Node of the compact representation
+   *
+   * A node is shared by all the metadata whose list contains the same
+   * item followed by the same nodes, and it is never modified once
+   * it has been created, except for its reference count.
+   */
+  struct Node {
+    /** number of references to this node: metadata and previous nodes */
+    uint32_t count;
+    /** the uid of the type of the header or trailer, zero for payload */
+    uint32_t uid;
+    /** the size (in bytes) of the header or trailer */
+    uint32_t size;
+    /** offset (in bytes) from start of original header to
+       the start of the fragment still present. */
+    uint32_t fragmentStart;
+    /** offset (in bytes) from start of original header to
+       the end of the fragment still present. */
+    uint32_t fragmentEnd;
+    /** the uid of the chunk, unique within the list: the fragments of
+       the same chunk share it. */
+    uint16_t chunkUid;
+    /** the largest chunk uid of this node and of the nodes which follow */
+    uint16_t maxChunkUid;
+    /** the packetUid of the packet in which this header or trailer
+       was first added, or zero if isOwn is true. */
+    uint64_t packetUid;
+    /** true if the item was first added to the packet which holds
+       the metadata. */
+    bool isOwn;
+    /** the next node of the list, or zero at the tail */
+    struct Node *next;
+    /** the next node of the same bucket of the node table */
+    struct Node *chain;
+    /** the hash of the fields above, except count and chain */
+    uint32_t hash;
   };
 
-  friend DataFreeList::~DataFreeList ();
   friend class ItemIterator;
 
   PacketMetadata ();
+  /**
+   * \brief Constructor of empty metadata in the default representation
+   * \param uid packet uid
+   */
+  explicit PacketMetadata (uint64_t uid);
 
   /**
    * \brief Add a SmallItem
@@ -594,6 +671,38 @@ public:
    */
   void ReserveCopy (uint32_t n);
 
+  /**
+   * \brief Get the items of the metadata, in either representation
+   * \param items the items, from head to tail, whose packetUid field
+   *        is set whether or not they were first added to this packet
+   */
+  void GetItems (std::vector<struct Node> &items) const;
+  /**
+   * \brief Replace the items of the metadata, keeping its representation
+   * \param items the items, from head to tail, whose packetUid field
+   *        is set
+   */
+  void SetItems (const std::vector<struct Node> &items);
+  /**
+   * \brief Replace the list of the compact representation
+   * \param head the new head node, whose reference is transferred
+   *        to the metadata
+   */
+  void SetHead (struct Node *head);
+  /**
+   * \brief Find or create the node of the compact representation
+   * of an item
+   * \param item the fields of the node, count, chain and hash aside
+   * \returns the node, with a reference for the caller
+   */
+  static struct Node *LookupNode (const struct Node &item);
+  /**
+   * \brief Release a reference to a node of the compact representation,
+   * and delete the nodes which are no longer referenced
+   * \param node the node, or zero
+   */
+  static void ReleaseNode (struct Node *node);
+
   /**
    * \brief Get the total size used by the metadata
    */
@@ -656,9 +765,9 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
+  static bool m_compact; //!< Use the compact representation
 
   /**
    * Set to true when adding metadata to a packet is skipped because
@@ -669,8 +778,12 @@ public:
 
   static uint32_t m_maxSize; //!< maximum metadata size
   static uint16_t m_chunkUid; //!< Chunk Uid
+  static struct Node **m_nodes; //!< Buckets of the table of the nodes
+  static uint32_t m_nBuckets; //!< Number of buckets of the table
+  static uint32_t m_nNodes; //!< Number of nodes in the table
 
-  struct Data *m_data; //!< Metadata storage
+  struct Data *m_data; //!< Metadata storage, or zero in the compact representation
+  struct Node *m_node; //!< Head of the compact representation, or zero
   /*
      head -(next)-> tail
        ^             |
@@ -687,13 +800,17 @@ public:
 namespace ns3 {
 
 PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
-  : m_data (PacketMetadata::Create (10)),
+  : m_data (m_compact ? 0 : PacketMetadata::Create (10)),
+    m_node (0),
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
     m_packetUid (uid)
 {
-  memset (m_data->m_data, 0xff, 4);
+  if (m_data != 0)
+    {
+      memset (m_data->m_data, 0xff, 4);
+    }
   if (size > 0)
     {
       DoAddHeader (0, size);
@@ -701,14 +818,21 @@ PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
 }
 PacketMetadata::PacketMetadata (PacketMetadata const &o)
   : m_data (o.m_data),
+    m_node (o.m_node),
     m_head (o.m_head),
     m_tail (o.m_tail),
     m_used (o.m_used),
     m_packetUid (o.m_packetUid)
 {
-  NS_ASSERT (m_data != 0);
-  NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
-  m_data->m_count++;
+  if (m_data != 0)
+    {
+      NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
+      m_data->m_count++;
+    }
+  if (m_node != 0)
+    {
+      m_node->count++;
+    }
 }
 PacketMetadata &
 PacketMetadata::operator = (PacketMetadata const& o)
@@ -716,15 +840,28 @@ PacketMetadata::operator = (PacketMetadata const& o)
   if (m_data != o.m_data) 
     {
       // not self assignment
-      NS_ASSERT (m_data != 0);
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (m_data != 0)
         {
-          PacketMetadata::Recycle (m_data);
+          m_data->m_count--;
+          if (m_data->m_count == 0) 
+            {
+              PacketMetadata::Recycle (m_data);
+            }
         }
       m_data = o.m_data;
-      NS_ASSERT (m_data != 0);
-      m_data->m_count++;
+      if (m_data != 0)
+        {
+          m_data->m_count++;
+        }
+    }
+  if (m_node != o.m_node)
+    {
+      if (o.m_node != 0)
+        {
+          o.m_node->count++;
+        }
+      PacketMetadata::ReleaseNode (m_node);
+      m_node = o.m_node;
     }
   m_head = o.m_head;
   m_tail = o.m_tail;
@@ -734,11 +871,17 @@ PacketMetadata::operator = (PacketMetadata const& o)
 }
 PacketMetadata::~PacketMetadata ()
 {
-  NS_ASSERT (m_data != 0);
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (m_data != 0)
+    {
+      m_data->m_count--;
+      if (m_data->m_count == 0) 
+        {
+          PacketMetadata::Recycle (m_data);
+        }
+    }
+  if (m_node != 0)
     {
-      PacketMetadata::Recycle (m_data);
+      PacketMetadata::ReleaseNode (m_node);
     }
 }
 
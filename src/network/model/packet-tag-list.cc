@@ -20,7 +20,7 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a copy-on-write array of Packet tags.
 */
 
 #include "packet-tag-list.h"
@@ -28,261 +28,181 @@
 #include "tag.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include <algorithm>
 #include <cstring>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
-bool
-PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
+uint32_t PacketTagList::m_maxCapacity = PacketTagList::INITIAL_CAPACITY;
+/**
+ * The free lists of the PacketTagList::Data blocks.  The lists
+ * created or destroyed by the static constructors or destructors which
+ * run before or after those of this compilation unit bypass it.
+ */
+static DataCache g_cache (1000, 4000);
+
+DataCache::Stats
+PacketTagList::GetCacheStats (void)
 {
-  TypeId tid = tag.GetInstanceTypeId ();
-  NS_LOG_FUNCTION (this << tid);
-  NS_LOG_INFO     ("looking for " << tid);
+  return g_cache.GetStats ();
+}
 
-  // trivial case when list is empty
-  if (m_next == 0)
+struct PacketTagList::Data *
+PacketTagList::Allocate (uint32_t capacity)
+{
+  NS_LOG_FUNCTION (capacity);
+  NS_ASSERT (capacity <= 0xffff);
+  if (capacity > m_maxCapacity)
     {
-      return false;
+      m_maxCapacity = capacity;
     }
-
-  bool found = false;
-
-  struct TagData ** prevNext = &m_next; // previous node's next pointer
-  struct TagData  * cur      =  m_next; // cursor to current node
-  struct TagData  * it = 0;             // utility
-
-  // Search from the head of the list until we find tid or a merge
-  while (cur != 0)
+  uint8_t *block = g_cache.Get (sizeof (struct Data) + (capacity - 1) * sizeof (struct TagData));
+  struct Data *data;
+  if (block != 0)
     {
-      if (cur->count > 1)
-        {
-          // found merge
-          NS_LOG_INFO ("found initial merge before tid");
-          break;
-        }
-      else if (cur->tid == tid)
-        {
-          NS_LOG_INFO ("found tid before initial merge, calling writer");
-          found = (this->*Writer)(tag, true, cur, prevNext);
-          break;
-        }
-      else
-        {
-          // no merge or tid found yet, move on
-          prevNext = &cur->next;
-          cur      =  cur->next;
-        }
-    }  // while !found && !cow
-
-  // did we find it or run out of tags?
-  if (cur == 0 || found)
+      // a cached block keeps its capacity
+      data = reinterpret_cast<struct Data *> (block);
+    }
+  else
     {
-      NS_LOG_INFO ("returning after header with found: " << found);
-      return found;
+      NS_LOG_LOGIC ("allocate capacity=" << m_maxCapacity);
+      block = new uint8_t [sizeof (struct Data) + (m_maxCapacity - 1) * sizeof (struct TagData)];
+      data = reinterpret_cast<struct Data *> (block);
+      data->m_capacity = m_maxCapacity;
     }
+  data->m_count = 1;
+  data->m_size = 0;
+  return data;
+}
 
-  // From here on out, we have to copy the list
-  // until we find tid, then link past it
+void
+PacketTagList::Recycle (struct Data *data)
+{
+  NS_LOG_FUNCTION (data);
+  NS_ASSERT (data->m_count == 0);
+  uint8_t *block = reinterpret_cast<uint8_t *> (data);
+  if (!g_cache.Put (block, sizeof (struct Data) + (data->m_capacity - 1) * sizeof (struct TagData)))
+    {
+      delete [] block;
+    }
+}
 
-  // Before we do all that work, let's make sure tid really exists
-  for (it = cur; it != 0; it = it->next)
+void
+PacketTagList::Reserve (uint32_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  if (m_data != 0 && m_data->m_count == 1 && m_data->m_capacity >= capacity)
     {
-      if (it->tid == tid)
-        {
-          break;
-        }
+      return;
     }
-  if (it == 0)
+  if (m_data != 0 && capacity > m_data->m_capacity)
     {
-      // got to end of list without finding tid
-      NS_LOG_INFO ("tid not found after first merge");
-      return found;
+      // grow geometrically, like the other lists
+      capacity = std::max (capacity, 2U * m_data->m_capacity);
     }
-
-  // At this point cur is a merge, but untested for tid
-  NS_ASSERT (cur != 0);
-  NS_ASSERT (cur->count > 1);
-
-  /*
-     Walk the remainder of the list, copying, until we find tid
-     As we put a copy of the cur node onto our list,
-     we move the merge point down the list.
-
-     Starting position                  End position
-       T1 is a merge                     T1.count decremented
-                                         T2 is a merge
-                                         T1' is a copy of T1
-
-          other                             other
-               \                                 \
-      Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-           /   /                                         /|
-      pNext cur                         Prev  ->  T1' --/ |
-                                                     /    |
-                                                pNext   cur
-
-     When we reach tid, we link past it, decrement count, and we're done.
-  */
-
-  // Should normally check for null cur pointer,
-  // but since we know tid exists, we'll skip this test
-  while ( /* cur && */ cur->tid != tid)
+  struct Data *data = Allocate (capacity);
+  if (m_data != 0)
     {
-      NS_ASSERT (cur != 0);
-      NS_ASSERT (cur->count > 1);
-      cur->count--;                       // unmerge cur
-      struct TagData * copy = new struct TagData ();
-      copy->tid = cur->tid;
-      copy->count = 1;
-      memcpy (copy->data, cur->data, TagData::MAX_SIZE);
-      copy->next = cur->next;             // merge into tail
-      copy->next->count++;                // mark new merge
-      *prevNext = copy;                   // point prior list at copy
-      prevNext = &copy->next;             // advance
-      cur      =  copy->next;
+      // copy all the tags at once, and leave the old block to its other users
+      std::memcpy (static_cast<void *> (data->m_tags), m_data->m_tags,
+                   m_data->m_size * sizeof (struct TagData));
+      data->m_size = m_data->m_size;
+      RemoveAll ();
     }
-  // Sanity check:
-  NS_ASSERT (cur != 0);                 // cur should be non-zero
-  NS_ASSERT (cur->tid == tid);          // cur->tid should be tid
-  NS_ASSERT (cur->count > 1);           // cur should be a merge
-
-  // link around tid, removing it from our list
-  found = (this->*Writer)(tag, false, cur, prevNext);
-  return found;
-
+  m_data = data;
 }
 
-bool
-PacketTagList::Remove (Tag & tag)
+int32_t
+PacketTagList::Find (TypeId tid) const
 {
-  return COWTraverse (tag, &PacketTagList::RemoveWriter);
-}
-
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
-                             struct PacketTagList::TagData  * cur,
-                             struct PacketTagList::TagData ** prevNext)
-{
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  tag.Deserialize (TagBuffer (cur->data,
-                              cur->data + TagData::MAX_SIZE));
-  *prevNext = cur->next;            // link around cur
-
-  if (preMerge)
+  if (m_data == 0)
     {
-      // found tid before first merge, so delete cur
-      delete cur;
+      return -1;
     }
-  else
+  for (uint32_t i = 0; i < m_data->m_size; i++)
     {
-      // cur is always a merge at this point
-      // unmerge cur, since we linked around it already
-      cur->count--;
-      if (cur->next != 0)
+      if (m_data->m_tags[i].tid == tid)
         {
-          // there's a next, so make it a merge
-          cur->next->count++;
+          return i;
         }
     }
-  return found;
+  return -1;
 }
 
 bool
-PacketTagList::Replace (Tag & tag)
+PacketTagList::Remove (Tag & tag)
 {
-  bool found = COWTraverse (tag, &PacketTagList::ReplaceWriter);
-  if (!found)
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid);
+  if (i < 0)
     {
-      Add (tag);
+      return false;
+    }
+  tag.Deserialize (TagBuffer (m_data->m_tags[i].data,
+                              m_data->m_tags[i].data + TagData::MAX_SIZE));
+  if (m_data->m_size == 1)
+    {
+      RemoveAll ();
+      return true;
     }
-  return found;
+  Reserve (m_data->m_size);
+  std::memmove (static_cast<void *> (&m_data->m_tags[i]), &m_data->m_tags[i + 1],
+                (m_data->m_size - i - 1) * sizeof (struct TagData));
+  m_data->m_size--;
+  return true;
 }
 
-// COWWriter implementing Replace
 bool
-PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
-                              struct PacketTagList::TagData  * cur,
-                              struct PacketTagList::TagData ** prevNext)
+PacketTagList::Replace (Tag & tag)
 {
-  NS_LOG_FUNCTION_NOARGS ();
-
-  // found tid
-  bool found = true;
-  if (preMerge)
-    {
-      // found tid before first merge, so just rewrite
-      tag.Serialize (TagBuffer (cur->data,
-                                cur->data + tag.GetSerializedSize ()));
-    }
-  else
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid);
+  if (i < 0)
     {
-      // cur is always a merge at this point
-      // need to copy, replace, and link past cur
-      cur->count--;                     // unmerge cur
-      struct TagData * copy = new struct TagData ();
-      copy->tid = tag.GetInstanceTypeId ();
-      copy->count = 1;
-      tag.Serialize (TagBuffer (copy->data,
-                                copy->data + tag.GetSerializedSize ()));
-      copy->next = cur->next;           // merge into tail
-      if (copy->next != 0)
-        {
-          copy->next->count++;          // mark new merge
-        }
-      *prevNext = copy;                 // point prior list at copy
+      Add (tag);
+      return false;
     }
-  return found;
+  Reserve (m_data->m_size);
+  tag.Serialize (TagBuffer (m_data->m_tags[i].data,
+                            m_data->m_tags[i].data + tag.GetSerializedSize ()));
+  return true;
 }
 
 void 
 PacketTagList::Add (const Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
+  TypeId tid = tag.GetInstanceTypeId ();
+  NS_LOG_FUNCTION (this << tid);
   // ensure this id was not yet added
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
-    {
-      NS_ASSERT_MSG (cur->tid != tag.GetInstanceTypeId (), "Error: cannot add the same kind of tag twice.");
-    }
-  struct TagData * head = new struct TagData ();
-  head->count = 1;
-  head->next = 0;
-  head->tid = tag.GetInstanceTypeId ();
-  head->next = m_next;
+  NS_ASSERT_MSG (Find (tid) < 0, "Error: cannot add the same kind of tag twice.");
   NS_ASSERT (tag.GetSerializedSize () <= TagData::MAX_SIZE);
-  tag.Serialize (TagBuffer (head->data, head->data + tag.GetSerializedSize ()));
 
-  const_cast<PacketTagList *> (this)->m_next = head;
+  PacketTagList *self = const_cast<PacketTagList *> (this);
+  self->Reserve (GetNTags () + 1);
+  struct TagData *cur = &m_data->m_tags[m_data->m_size];
+  cur->tid = tid;
+  tag.Serialize (TagBuffer (cur->data, cur->data + tag.GetSerializedSize ()));
+  m_data->m_size++;
 }
 
 bool
 PacketTagList::Peek (Tag &tag) const
 {
-  NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
+  NS_LOG_FUNCTION (this << tid);
+  int32_t i = Find (tid);
+  if (i < 0)
     {
-      if (cur->tid == tid) 
-        {
-          /* found tag */
-          tag.Deserialize (TagBuffer (cur->data, cur->data + TagData::MAX_SIZE));
-          return true;
-        }
+      /* no tag found */
+      return false;
     }
-  /* no tag found */
-  return false;
-}
-
-const struct PacketTagList::TagData *
-PacketTagList::Head (void) const
-{
-  return m_next;
+  tag.Deserialize (TagBuffer (m_data->m_tags[i].data,
+                              m_data->m_tags[i].data + TagData::MAX_SIZE));
+  return true;
 }
 
 } /* namespace ns3 */
-
@@ -22,12 +22,13 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a copy-on-write array of Packet tags.
 */
 
 #include <stdint.h>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "data-cache.h"
 
 namespace ns3 {
 
@@ -43,96 +44,36 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ *   - Tags are stored in serialized form in an array of TagData,
+ *     held in a single, reference-counted Data block, in the order in
+ *     which they were added.  An empty list holds no block at all.
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      };
- * \enddot
- *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
- *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ *   - The few tags of a packet are found by a linear scan of the
+ *     array, which is contiguous in memory.
  *
  * \par <b> Copy-on-write </b> is implemented as follows:
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
  *   - Copy constructor (PacketTagList(const PacketTagList & o))
- *     and assignment (#operator=(const PacketTagList & o)
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *     and assignment (#operator=(const PacketTagList & o))
+ *     simply share the block of the original PacketTagList \c o,
+ *     incrementing its \c m_count.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - #Add, #Remove and #Replace write to the block in place if it is
+ *     not shared.  Otherwise, they copy all its tags in a new block
+ *     with a single memcpy, and leave the shared block to the other
+ *     lists.  Since #Add does not change the tags seen by the other
+ *     lists, it is a \c const function.
  *
  * \par <b> Memory Management: </b>
  * \n
- * Packet tags must serialize to a finite maximum size, see TagData
- *
- * This documentation entitles the original author to a free beer.
+ * Packet tags must serialize to a finite maximum size, see TagData.
+ * The blocks are recycled through a DataCache, see GetCacheStats.
  */
 class PacketTagList 
 {
 public:
   /**
-   * Tree node for sharing serialized tags.
-   *
-   * See PacketTagList for a discussion of the data structure.
+   * Serialized tag.
    *
    * See TagData::TagData_e for a discussion of the size limit on
    * tag serialization.
@@ -146,15 +87,9 @@ public:
      * in this constant.
      *
      * \internal
-     * Ideally, TagData would be 32 bytes in size, so they require
-     * no padding on 64-bit architectures.  (The architecture
-     * affects the size because of the \c #next pointer.)
-     * This would leave 18 bytes for \c #data.  However,
-     * ns3:Ipv6PacketInfoTag needs 19 bytes!  The current
-     * implementation allows 20 bytes, which gives TagData
-     * a size of 30 bytes on 32-byte machines (which gets
-     * padded with 2 bytes), and 34 bytes on 64-bit machines, which
-     * gets padded to 40 bytes.
+     * ns3:Ipv6PacketInfoTag needs 19 bytes.  The current implementation
+     * allows 21 bytes, which, with the \c #tid, gives TagData a size of
+     * 24 bytes on all architectures.
      */
     enum TagData_e
     {
@@ -162,9 +97,7 @@ public:
   };
 
     uint8_t data[MAX_SIZE];   /**< Serialization buffer */
-    struct TagData * next;   /**< Pointer to next in list */
     TypeId tid;               /**< Type of the tag serialized into #data */
-    uint32_t count;           /**< Number of incoming links */
   };  /* struct TagData */
 
   /**
@@ -176,8 +109,8 @@ public:
    *
    * \param [in] o The PacketTagList to copy.
    *
-   * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * This makes a light-weight copy, which shares the tags
+   * of \pname{o}.
    */
   inline PacketTagList (PacketTagList const &o);
   /**
@@ -187,18 +120,18 @@ public:
    * \returns the copied object
    *
    * This makes a light-weight copy by #RemoveAll, then
-   * pointing to the same \ref TagData as \pname{o}.
+   * sharing the tags of \pname{o}.
    */
   inline PacketTagList &operator = (PacketTagList const &o);
   /**
    * Destructor
    *
-   * #RemoveAll's the tags up to the first merge.
+   * #RemoveAll's the tags.
    */
   inline ~PacketTagList ();
 
   /**
-   * Add a tag to the head of this branch.
+   * Add a tag at the end of this list.
    *
    * \param [in] tag The tag to add
    */
@@ -230,67 +163,79 @@ public:
    */
   bool Peek (Tag &tag) const;
   /**
-   * Remove all tags from this list (up to the first merge).
+   * Remove all tags from this list.
    */
   inline void RemoveAll (void);
   /**
-   * \returns pointer to head of tag list
+   * \returns pointer to the array of the tags, in the order in which
+   *          they were added, or zero if the list is empty
    */
-  const struct PacketTagList::TagData *Head (void) const;
+  inline const struct PacketTagList::TagData *GetTags (void) const;
+  /**
+   * \returns the number of tags in the list
+   */
+  inline uint32_t GetNTags (void) const;
+
+  /**
+   * Get the statistics of the cache of the tag arrays.
+   *
+   * \returns The statistics, summed over all threads.
+   */
+  static DataCache::Stats GetCacheStats (void);
 
 private:
   /**
-   * Typedef of method function pointer for copy-on-write operations
+   * The reference-counted block which holds the tags.
+   */
+  struct Data
+  {
+    uint32_t m_count;     /**< Number of PacketTagList's sharing the block */
+    uint16_t m_capacity;  /**< Number of TagData which fit in the block */
+    uint16_t m_size;      /**< Number of TagData in use */
+    /**
+     * The tags: the block is allocated with room for \c m_capacity
+     * of them.
+     */
+    struct TagData m_tags[1];
+  };
+
+  /** Number of tags of the first block of a list. */
+  static const uint32_t INITIAL_CAPACITY = 4;
+
+  /**
+   * Allocate a block, from the cache if possible.
    *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True if operation successful, false otherwise
+   * \param [in] capacity The minimum number of tags of the block.
+   * \returns The block, with a single reference and no tag.
    */
-  typedef bool (PacketTagList::*COWWriter)
-    (Tag       & tag, bool         preMerge,
-    struct TagData * cur, struct TagData ** prevNext);
+  static struct Data *Allocate (uint32_t capacity);
   /**
-   * Traverse the list implementing copy-on-write, using \pname{Writer}.
+   * Release a block which is no longer referenced to the cache.
    *
-   * \param [in] tag The tag type to operate on.
-   * \param [in] Writer The copy-on-write function to use.
-   * \returns True if \pname{tag} found, false otherwise.
+   * \param [in] data The block.
    */
-  bool COWTraverse   (Tag & tag, PacketTagList::COWWriter Writer);
+  static void Recycle (struct Data *data);
   /**
-   * Copy-on-write implementing Remove.
+   * Make sure that this list owns its block, which has room
+   * for \pname{capacity} tags, copying the tags to a new block if needed.
    *
-   * \param [in] tag The target tag type to remove.
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *             false otherwise.
-   * \param [in] cur Pointer to the tag.
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag will definitely be removed.
+   * \param [in] capacity The number of tags the block must hold.
    */
-  bool RemoveWriter  (Tag       & tag, bool         preMerge,
-                      struct TagData * cur, struct TagData ** prevNext);
+  void Reserve (uint32_t capacity);
   /**
-   * Copy-on-write implementing Replace
+   * Find a tag.
    *
-   * \param [in] tag The target tag type to replace
-   * \param [in] preMerge True if \pname{tag} was found before the first merge,
-   *          false otherwise.
-   * \param [in] cur Pointer to the tag
-   * \param [in] prevNext Pointer to the struct TagData.next pointer
-   *          pointing to \pname{cur}.
-   * \returns True, since tag value will definitely be replaced.
+   * \param [in] tid The tag type to find.
+   * \returns The index of the tag in the array, or -1 if it is not found.
    */
-  bool ReplaceWriter (Tag & tag, bool preMerge, struct TagData * cur, struct TagData ** prevNext);
+  int32_t Find (TypeId tid) const;
+
+  static uint32_t m_maxCapacity; //!< Capacity of the largest block allocated
 
   /**
-   * Pointer to first \ref TagData on the list
+   * The block of the tags, or zero if the list is empty
    */
-  struct TagData *m_next;
+  struct Data *m_data;
 };
 
 } // namespace ns3
@@ -302,16 +247,16 @@ private:
 namespace ns3 {
 
 PacketTagList::PacketTagList ()
-  : m_next ()
+  : m_data (0)
 {
 }
 
 PacketTagList::PacketTagList (PacketTagList const &o)
-  : m_next (o.m_next)
+  : m_data (o.m_data)
 {
-  if (m_next != 0)
+  if (m_data != 0)
     {
-      m_next->count++;
+      m_data->m_count++;
     }
 }
 
@@ -319,15 +264,15 @@ PacketTagList &
 PacketTagList::operator = (PacketTagList const &o)
 {
   // self assignment
-  if (m_next == o.m_next) 
+  if (m_data == o.m_data) 
     {
       return *this;
     }
   RemoveAll ();
-  m_next = o.m_next;
-  if (m_next != 0) 
+  m_data = o.m_data;
+  if (m_data != 0) 
     {
-      m_next->count++;
+      m_data->m_count++;
     }
   return *this;
 }
@@ -340,25 +285,27 @@ PacketTagList::~PacketTagList ()
 void
 PacketTagList::RemoveAll (void)
 {
-  struct TagData *prev = 0;
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  if (m_data != 0)
     {
-      cur->count--;
-      if (cur->count > 0) 
-        {
-          break;
-        }
-      if (prev != 0) 
+      m_data->m_count--;
+      if (m_data->m_count == 0)
         {
-	  delete prev;
+          Recycle (m_data);
         }
-      prev = cur;
+      m_data = 0;
     }
-  if (prev != 0) 
-    {
-      delete prev;
-    }
-  m_next = 0;
+}
+
+const struct PacketTagList::TagData *
+PacketTagList::GetTags (void) const
+{
+  return m_data != 0 ? m_data->m_tags : 0;
+}
+
+uint32_t
+PacketTagList::GetNTags (void) const
+{
+  return m_data != 0 ? m_data->m_size : 0;
 }
 
 } // namespace ns3
@@ -23,6 +23,7 @@
 #include "ns3/simulator.h"
 #include <string>
 #include <cstdarg>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -81,22 +82,22 @@ ByteTagIterator::ByteTagIterator (ByteTagList::Iterator i)
 }
 
 
-PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *head)
-  : m_current (head)
+PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *tags, uint32_t n)
+  : m_tags (tags),
+    m_left (n)
 {
 }
 bool
 PacketTagIterator::HasNext (void) const
 {
-  return m_current != 0;
+  return m_left != 0;
 }
 PacketTagIterator::Item
 PacketTagIterator::Next (void)
 {
   NS_ASSERT (HasNext ());
-  const struct PacketTagList::TagData *prev = m_current;
-  m_current = m_current->next;
-  return PacketTagIterator::Item (prev);
+  m_left--;
+  return PacketTagIterator::Item (&m_tags[m_left]);
 }
 
 PacketTagIterator::Item::Item (const struct PacketTagList::TagData *data)
@@ -129,6 +130,7 @@ Packet::Copy (void) const
 
 Packet::Packet ()
   : m_buffer (),
+    m_slicesSize (0),
     m_byteTagList (),
     m_packetTagList (),
     /* The upper 32 bits of the packet id in 
@@ -145,6 +147,8 @@ Packet::Packet ()
 
 Packet::Packet (const Packet &o)
   : m_buffer (o.m_buffer),
+    m_slices (o.m_slices),
+    m_slicesSize (o.m_slicesSize),
     m_byteTagList (o.m_byteTagList),
     m_packetTagList (o.m_packetTagList),
     m_metadata (o.m_metadata)
@@ -161,6 +165,8 @@ Packet::operator = (const Packet &o)
       return *this;
     }
   m_buffer = o.m_buffer;
+  m_slices = o.m_slices;
+  m_slicesSize = o.m_slicesSize;
   m_byteTagList = o.m_byteTagList;
   m_packetTagList = o.m_packetTagList;
   m_metadata = o.m_metadata;
@@ -171,6 +177,7 @@ Packet::operator = (const Packet &o)
 
 Packet::Packet (uint32_t size)
   : m_buffer (size),
+    m_slicesSize (0),
     m_byteTagList (),
     m_packetTagList (),
     /* The upper 32 bits of the packet id in 
@@ -186,6 +193,7 @@ Packet::Packet (uint32_t size)
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
+    m_slicesSize (0),
     m_byteTagList (),
     m_packetTagList (),
     m_metadata (0,0),
@@ -197,6 +205,7 @@ Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
 
 Packet::Packet (uint8_t const*buffer, uint32_t size)
   : m_buffer (),
+    m_slicesSize (0),
     m_byteTagList (),
     m_packetTagList (),
     /* The upper 32 bits of the packet id in 
@@ -217,6 +226,7 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
 Packet::Packet (const Buffer &buffer,  const ByteTagList &byteTagList, 
                 const PacketTagList &packetTagList, const PacketMetadata &metadata)
   : m_buffer (buffer),
+    m_slicesSize (0),
     m_byteTagList (byteTagList),
     m_packetTagList (packetTagList),
     m_metadata (metadata),
@@ -228,19 +238,69 @@ Ptr<Packet>
 Packet::CreateFragment (uint32_t start, uint32_t length) const
 {
   NS_LOG_FUNCTION (this << start << length);
-  Buffer buffer = m_buffer.CreateFragment (start, length);
   ByteTagList byteTagList = m_byteTagList;
   byteTagList.Adjust (-start);
-  NS_ASSERT (m_buffer.GetSize () >= start + length);
-  uint32_t end = m_buffer.GetSize () - (start + length);
+  NS_ASSERT (GetSize () >= start + length);
+  uint32_t end = GetSize () - (start + length);
   PacketMetadata metadata = m_metadata.CreateFragment (start, end);
   // again, call the constructor directly rather than
   // through Create because it is private.
-  Ptr<Packet> ret = Ptr<Packet> (new Packet (buffer, byteTagList, m_packetTagList, metadata), false);
+  Ptr<Packet> ret;
+  uint32_t k = 0;
+  uint32_t position = 0;
+  uint32_t left = length;
+  if (start == 0)
+    {
+      // the fragment starts with the packet buffer, where its
+      // headers can be added in place
+      uint32_t size = std::min (length, m_buffer.GetSize ());
+      ret = Ptr<Packet> (new Packet (m_buffer.CreateFragment (0, size), byteTagList, m_packetTagList, metadata), false);
+      left -= size;
+      position = m_buffer.GetSize ();
+      k = 1;
+    }
+  else
+    {
+      // the bytes of the fragment are slices of the buffers of
+      // this packet, after an empty buffer for its headers
+      ret = Ptr<Packet> (new Packet (Buffer (), byteTagList, m_packetTagList, metadata), false);
+    }
+  for (; k <= m_slices.size () && left > 0; k++)
+    {
+      const Buffer &part = (k == 0) ? m_buffer : m_slices[k - 1];
+      uint32_t size = part.GetSize ();
+      uint32_t current = start + length - left;
+      if (current < position + size)
+        {
+          uint32_t n = std::min (position + size - current, left);
+          ret->m_slices.push_back (part.CreateFragment (current - position, n));
+          ret->m_slicesSize += n;
+          left -= n;
+        }
+      position += size;
+    }
   ret->SetNixVector (GetNixVector ());
   return ret;
 }
 
+void
+Packet::JoinSlices (void) const
+{
+  NS_LOG_FUNCTION (this << m_slices.size ());
+  Packet *self = const_cast<Packet *> (this);
+  if (m_buffer.GetSize () == 0 && m_slices.size () == 1)
+    {
+      // a single slice becomes the packet buffer, without copy
+      self->m_buffer = m_slices.front ();
+    }
+  else
+    {
+      self->m_buffer.AddAtEnd (m_slices);
+    }
+  self->m_slices.clear ();
+  self->m_slicesSize = 0;
+}
+
 void
 Packet::SetNixVector (Ptr<NixVector> nixVector)
 {
@@ -267,6 +327,7 @@ Packet::AddHeader (const Header &header)
 uint32_t
 Packet::RemoveHeader (Header &header)
 {
+  Join ();
   uint32_t deserialized = header.Deserialize (m_buffer.Begin ());
   NS_LOG_FUNCTION (this << header.GetInstanceTypeId ().GetName () << deserialized);
   m_buffer.RemoveAtStart (deserialized);
@@ -277,6 +338,7 @@ Packet::RemoveHeader (Header &header)
 uint32_t
 Packet::PeekHeader (Header &header) const
 {
+  Join ();
   uint32_t deserialized = header.Deserialize (m_buffer.Begin ());
   NS_LOG_FUNCTION (this << header.GetInstanceTypeId ().GetName () << deserialized);
   return deserialized;
@@ -287,14 +349,27 @@ Packet::AddTrailer (const Trailer &trailer)
   uint32_t size = trailer.GetSerializedSize ();
   NS_LOG_FUNCTION (this << trailer.GetInstanceTypeId ().GetName () << size);
   m_byteTagList.AddAtEnd (GetSize ());
-  m_buffer.AddAtEnd (size);
-  Buffer::Iterator end = m_buffer.End ();
-  trailer.Serialize (end);
+  if (m_slices.empty ())
+    {
+      m_buffer.AddAtEnd (size);
+      Buffer::Iterator end = m_buffer.End ();
+      trailer.Serialize (end);
+    }
+  else
+    {
+      // the trailer is a new slice, which leaves the others shared
+      Buffer buffer;
+      buffer.AddAtEnd (size);
+      trailer.Serialize (buffer.End ());
+      m_slices.push_back (buffer);
+      m_slicesSize += size;
+    }
   m_metadata.AddTrailer (trailer, size);
 }
 uint32_t
 Packet::RemoveTrailer (Trailer &trailer)
 {
+  Join ();
   uint32_t deserialized = trailer.Deserialize (m_buffer.End ());
   NS_LOG_FUNCTION (this << trailer.GetInstanceTypeId ().GetName () << deserialized);
   m_buffer.RemoveAtEnd (deserialized);
@@ -304,6 +379,7 @@ Packet::RemoveTrailer (Trailer &trailer)
 uint32_t
 Packet::PeekTrailer (Trailer &trailer)
 {
+  Join ();
   uint32_t deserialized = trailer.Deserialize (m_buffer.End ());
   NS_LOG_FUNCTION (this << trailer.GetInstanceTypeId ().GetName () << deserialized);
   return deserialized;
@@ -318,7 +394,26 @@ Packet::AddAtEnd (Ptr<const Packet> packet)
   copy.AddAtStart (0);
   copy.Adjust (GetSize ());
   m_byteTagList.Add (copy);
-  m_buffer.AddAtEnd (packet->m_buffer);
+  // the buffers of the packet become slices of this one: read them
+  // before this packet changes, since both may be the same
+  Buffer buffer = packet->m_buffer;
+  std::vector<Buffer> slices = packet->m_slices;
+  uint32_t size = packet->GetSize ();
+  if (GetSize () == 0)
+    {
+      m_buffer = buffer;
+      m_slices.swap (slices);
+      m_slicesSize = size - m_buffer.GetSize ();
+    }
+  else
+    {
+      if (buffer.GetSize () != 0)
+        {
+          m_slices.push_back (buffer);
+        }
+      m_slices.insert (m_slices.end (), slices.begin (), slices.end ());
+      m_slicesSize += size;
+    }
   m_metadata.AddAtEnd (packet->m_metadata);
 }
 void
@@ -326,21 +421,54 @@ Packet::AddPaddingAtEnd (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
   m_byteTagList.AddAtEnd (GetSize ());
-  m_buffer.AddAtEnd (size);
+  if (m_slices.empty ())
+    {
+      m_buffer.AddAtEnd (size);
+    }
+  else
+    {
+      // a slice of virtual zero bytes
+      m_slices.push_back (Buffer (size));
+      m_slicesSize += size;
+    }
   m_metadata.AddPaddingAtEnd (size);
 }
 void 
 Packet::RemoveAtEnd (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  m_buffer.RemoveAtEnd (size);
+  uint32_t left = size;
+  while (left > 0 && !m_slices.empty ())
+    {
+      Buffer &last = m_slices.back ();
+      uint32_t n = std::min (left, last.GetSize ());
+      last.RemoveAtEnd (n);
+      m_slicesSize -= n;
+      left -= n;
+      if (last.GetSize () == 0)
+        {
+          m_slices.pop_back ();
+        }
+    }
+  m_buffer.RemoveAtEnd (left);
   m_metadata.RemoveAtEnd (size);
 }
 void 
 Packet::RemoveAtStart (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  m_buffer.RemoveAtStart (size);
+  uint32_t left = size - std::min (size, m_buffer.GetSize ());
+  m_buffer.RemoveAtStart (size - left);
+  while (m_buffer.GetSize () == 0 && !m_slices.empty ())
+    {
+      // the first slice becomes the packet buffer
+      m_buffer = m_slices.front ();
+      m_slices.erase (m_slices.begin ());
+      m_slicesSize -= m_buffer.GetSize ();
+      uint32_t n = std::min (left, m_buffer.GetSize ());
+      m_buffer.RemoveAtStart (n);
+      left -= n;
+    }
   m_byteTagList.Adjust (-size);
   m_metadata.RemoveAtStart (size);
 }
@@ -355,13 +483,32 @@ Packet::RemoveAllByteTags (void)
 uint32_t 
 Packet::CopyData (uint8_t *buffer, uint32_t size) const
 {
-  return m_buffer.CopyData (buffer, size);
+  uint32_t copied = m_buffer.CopyData (buffer, size);
+  for (std::vector<Buffer>::const_iterator i = m_slices.begin ();
+       i != m_slices.end () && copied < size; ++i)
+    {
+      copied += i->CopyData (buffer + copied, size - copied);
+    }
+  return copied;
 }
 
 void
 Packet::CopyData (std::ostream *os, uint32_t size) const
 {
-  return m_buffer.CopyData (os, size);
+  if (m_slices.empty ())
+    {
+      return m_buffer.CopyData (os, size);
+    }
+  uint32_t n = std::min (size, m_buffer.GetSize ());
+  m_buffer.CopyData (os, n);
+  size -= n;
+  for (std::vector<Buffer>::const_iterator i = m_slices.begin ();
+       i != m_slices.end () && size > 0; ++i)
+    {
+      n = std::min (size, i->GetSize ());
+      i->CopyData (os, n);
+      size -= n;
+    }
 }
 
 uint64_t 
@@ -411,6 +558,7 @@ Packet::ToString() const
 void 
 Packet::Print (std::ostream &os) const
 {
+  Join ();
   PacketMetadata::ItemIterator i = m_metadata.BeginItem (m_buffer);
   while (i.HasNext ())
     {
@@ -464,6 +612,7 @@ Packet::Print (std::ostream &os) const
   // define the right attributes which is not the case for
   // now. So, as a temporary measure, we use the 
   // headers' and trailers' Print method as shown above.
+  Join ();
   PacketMetadata::ItemIterator i = m_metadata.BeginItem (m_buffer);
   while (i.HasNext ())
     {
@@ -528,6 +677,7 @@ Packet::Print (std::ostream &os) const
 PacketMetadata::ItemIterator 
 Packet::BeginItem (void) const
 {
+  Join ();
   return m_metadata.BeginItem (m_buffer);
 }
 
@@ -538,6 +688,14 @@ Packet::EnablePrinting (void)
   PacketMetadata::Enable ();
 }
 
+void
+Packet::EnableCompactPrinting (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketMetadata::Enable ();
+  PacketMetadata::SetCompact (true);
+}
+
 void
 Packet::EnableChecking (void)
 {
@@ -579,6 +737,7 @@ uint32_t Packet::GetSerializedSize (void) const
 
   // increment total size by size of buffer 
   // ensuring 4-byte boundary
+  Join ();
   size += ((m_buffer.GetSerializedSize () + 3) & (~3));
 
   // add 4-bytes for entry of total length of buffer 
@@ -673,6 +832,7 @@ Packet::Serialize (uint8_t* buffer, uint32_t maxSize) const
     }
 
   // Serialize the packet contents
+  Join ();
   uint32_t bufSize = m_buffer.GetSerializedSize ();
   if (size + bufSize <= maxSize)
     {
@@ -881,7 +1041,7 @@ Packet::PrintPacketTags (std::ostream &os) const
 PacketTagIterator 
 Packet::GetPacketTagIterator (void) const
 {
-  return PacketTagIterator (m_packetTagList.Head ());
+  return PacketTagIterator (m_packetTagList.GetTags (), m_packetTagList.GetNTags ());
 }
 
 std::ostream& operator<< (std::ostream& os, const Packet &packet)
@@ -21,6 +21,7 @@
 #define PACKET_H
 
 #include <stdint.h>
+#include <vector>
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -169,10 +170,12 @@ private:
   friend class Packet;
   /**
    * Constructor
-   * \param head head of the items
+   * \param tags array of the items
+   * \param n number of items
    */
-  PacketTagIterator (const struct PacketTagList::TagData *head);
-  const struct PacketTagList::TagData *m_current;  //!< actual position over the set of tags in a packet
+  PacketTagIterator (const struct PacketTagList::TagData *tags, uint32_t n);
+  const struct PacketTagList::TagData *m_tags;  //!< the set of tags in a packet
+  uint32_t m_left;  //!< number of tags not yet returned, the most recent first
 };
 
 /**
@@ -195,7 +198,9 @@ private:
  * output from Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
- * Packet::EnablePrinting.
+ * Packet::EnablePrinting. Packet::EnableCompactPrinting enables the
+ * metadata with a representation which is shared between packets,
+ * to reduce the memory used by simulations which keep many packets.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -285,6 +290,8 @@ public:
    * packet.
    *
    * The returned packet shares the same uid as this packet.
+   * Its bytes are not copied: they are slices of the buffers of this
+   * packet, see \ref packetperf.
    *
    * \param start offset from start of packet to start of fragment to create
    * \param length length of fragment to create
@@ -361,7 +368,9 @@ public:
    * \brief Concatenate the input packet at the end of the current
    * packet.
    *
-   * This does not alter the uid of either packet.
+   * This does not alter the uid of either packet.  The bytes of the
+   * input packet are not copied: they are kept as slices of its buffers,
+   * see \ref packetperf.
    *
    * \param packet packet to concatenate
    */
@@ -490,6 +499,20 @@ public:
    * simulation setup and before any packet is created.
    */
   static void EnablePrinting (void);
+  /**
+   * \brief Enable printing packets metadata, with a compact representation
+   * of the metadata.
+   *
+   * Same as EnablePrinting, but the metadata of the packets created
+   * from now on are shared between the packets which carry the same
+   * headers and trailers, which saves a lot of memory when many packets
+   * are kept at once, for instance in the buffers of TCP sockets.
+   * Adding and removing headers is as fast as with EnablePrinting;
+   * adding and removing trailers and concatenating packets is slower.
+   *
+   * \sa PacketMetadata::SetCompact
+   */
+  static void EnableCompactPrinting (void);
   /**
    * \brief Enable packets metadata checking.
    *
@@ -713,7 +736,21 @@ private:
 
   uint32_t Deserialize (uint8_t const*buffer, uint32_t size);
 
+  /**
+   * \brief Join the slices to the packet buffer, if there are any,
+   * before the packet buffer is read.
+   *
+   * This does not change the content of the packet.
+   */
+  inline void Join (void) const;
+  /**
+   * \brief Join the slices to the packet buffer, with a single copy.
+   */
+  void JoinSlices (void) const;
+
   Buffer m_buffer;                //!< the packet buffer (it's actual contents)
+  std::vector<Buffer> m_slices;   //!< the buffers which follow m_buffer, shared with other packets
+  uint32_t m_slicesSize;          //!< the number of bytes of the slices
   ByteTagList m_byteTagList;      //!< the ByteTag list
   PacketTagList m_packetTagList;  //!< the packet's Tag list
   PacketMetadata m_metadata;      //!< the packet's metadata
@@ -772,6 +809,19 @@ std::ostream& operator<< (std::ostream& os, const Packet &packet);
  * dirty operations have been optimized for common use-cases which
  * means that most of the time, these operations will not trigger
  * data copies and will thus be still very fast.
+ *
+ * Fragmenting and reassembling packets does not copy their bytes
+ * either: the bytes of a fragment created by ns3::Packet::CreateFragment,
+ * or appended by ns3::Packet::AddAtEnd, are kept as a list of slices,
+ * which share the buffers of the original packets, after the buffer
+ * which holds the headers of the packet.  ns3::Packet::AddHeader,
+ * ns3::Packet::AddTrailer, ns3::Packet::AddPaddingAtEnd,
+ * ns3::Packet::RemoveAtStart, ns3::Packet::RemoveAtEnd,
+ * ns3::Packet::CreateFragment and ns3::Packet::CopyData work on the
+ * slices.  The other operations which read the bytes of the packet,
+ * such as ns3::Packet::RemoveHeader, ns3::Packet::Print or
+ * ns3::Packet::Serialize, first join the slices to the buffer, which
+ * copies their bytes once.
  */
 
 } // namespace ns3
@@ -785,7 +835,16 @@ namespace ns3 {
 uint32_t 
 Packet::GetSize (void) const
 {
-  return m_buffer.GetSize ();
+  return m_buffer.GetSize () + m_slicesSize;
+}
+
+void
+Packet::Join (void) const
+{
+  if (!m_slices.empty ())
+    {
+      JoinSlices ();
+    }
 }
 
 } // namespace ns3
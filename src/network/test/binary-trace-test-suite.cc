@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/ethernet-header.h"
+#include "ns3/binary-trace-file.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/trace-helper.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the binary trace files convert to the text of the
+ * ascii trace sinks, as a whole and by window of time.
+ */
+class BinaryTraceTestCase : public TestCase
+{
+public:
+  BinaryTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Trace the same events to the text and binary streams.
+   * \param i The number of the event.
+   */
+  void DoEvent (uint32_t i);
+
+  Ptr<OutputStreamWrapper> m_text;   //!< The stream of text
+  Ptr<OutputStreamWrapper> m_binary; //!< The binary stream
+  std::ostringstream m_expected;     //!< The text of all the events
+  std::ostringstream m_window;       //!< The text of the events of the window
+};
+
+BinaryTraceTestCase::BinaryTraceTestCase ()
+  : TestCase ("Convert binary traces to ascii traces")
+{
+}
+
+void
+BinaryTraceTestCase::DoEvent (uint32_t i)
+{
+  std::ostringstream context;
+  context << "/NodeList/" << i % 3 << "/DeviceList/0/$ns3::PointToPointNetDevice/TxQueue/Enqueue";
+  Ptr<Packet> p = Create<Packet> (100 + i);
+  EthernetHeader header;
+  header.SetLengthType (100 + i);
+  p->AddHeader (header);
+
+  std::ostringstream text;
+  Ptr<OutputStreamWrapper> windowText = Create<OutputStreamWrapper> (&text);
+  Ptr<OutputStreamWrapper> streams[] = { m_text, m_binary, windowText };
+  for (uint32_t j = 0; j < 3; j++)
+    {
+      switch (i % 5)
+        {
+        case 0:
+          AsciiTraceHelper::DefaultEnqueueSinkWithContext (streams[j], context.str (), p);
+          break;
+        case 1:
+          AsciiTraceHelper::DefaultDequeueSinkWithContext (streams[j], context.str (), p);
+          break;
+        case 2:
+          AsciiTraceHelper::DefaultDropSinkWithoutContext (streams[j], p);
+          break;
+        case 3:
+          AsciiTraceHelper::DefaultReceiveSinkWithContext (streams[j], context.str (), p);
+          break;
+        default:
+          *streams[j]->GetStream () << "t " << Simulator::Now ().GetSeconds () << " text " << i << std::endl;
+          break;
+        }
+    }
+  if (Simulator::Now () >= MilliSeconds (50) && Simulator::Now () <= MilliSeconds (59))
+    {
+      m_window << text.str ();
+    }
+}
+
+void
+BinaryTraceTestCase::DoRun (void)
+{
+  Packet::EnablePrinting ();
+
+  const uint32_t nEvents = 100;
+  std::string filename = CreateTempDirFilename ("binary-trace.btr");
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> ();
+  file->SetIndexInterval (4);
+  file->Open (filename, std::ios::out);
+  NS_TEST_ASSERT_MSG_EQ (file->Fail (), false, "Open (" << filename << ", std::ios::out) returns error");
+  m_binary = Create<OutputStreamWrapper> (file);
+  m_text = Create<OutputStreamWrapper> (&m_expected);
+  for (uint32_t i = 0; i < nEvents; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &BinaryTraceTestCase::DoEvent, this, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_binary = 0;
+  m_text = 0;
+  file->Close ();
+  NS_TEST_ASSERT_MSG_EQ (file->Fail (), false, "Close () returns error");
+
+  Ptr<BinaryTraceFile> in = Create<BinaryTraceFile> ();
+  in->Open (filename, std::ios::in);
+  NS_TEST_ASSERT_MSG_EQ (in->Fail (), false, "Open (" << filename << ", std::ios::in) returns error");
+  NS_TEST_EXPECT_MSG_EQ (in->GetResolution (), Time::GetResolution (), "Unexpected resolution");
+  NS_TEST_EXPECT_MSG_EQ (in->GetNIndexEntries (), nEvents / 4, "Unexpected number of index entries");
+
+  std::ostringstream all;
+  uint64_t nRecords = in->Convert (all);
+  NS_TEST_EXPECT_MSG_EQ (nRecords, nEvents, "Unexpected number of records");
+  NS_TEST_EXPECT_MSG_EQ (all.str (), m_expected.str (), "The converted trace differs from the ascii trace");
+
+  std::ostringstream window;
+  nRecords = in->Convert (window, MilliSeconds (50), MilliSeconds (59));
+  NS_TEST_EXPECT_MSG_EQ (window.str (), m_window.str (), "The converted window differs from the ascii trace");
+  // The records from the index entry at 48 ms to the one after the window
+  NS_TEST_EXPECT_MSG_EQ (nRecords, 13, "The window was not found with the index");
+  in->Close ();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace file TestSuite
+ */
+class BinaryTraceTestSuite : public TestSuite
+{
+public:
+  BinaryTraceTestSuite ();
+};
+
+BinaryTraceTestSuite::BinaryTraceTestSuite ()
+  : TestSuite ("binary-trace-file", UNIT)
+{
+  AddTestCase (new BinaryTraceTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -22,6 +22,8 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/double.h"
 #include "ns3/test.h"
+#include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -361,6 +363,133 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 //-----------------------------------------------------------------------------
+class BufferZeroAreaTest : public TestCase {
+private:
+  /**
+   * Create a buffer with real bytes around a zero area.
+   *
+   * \param [in] start The number of real bytes before the zero area.
+   * \param [in] zero The size of the zero area.
+   * \param [in] end The number of real bytes after the zero area.
+   * \param [in] value The value of the real bytes.
+   * \returns The buffer.
+   */
+  Buffer Create (uint32_t start, uint32_t zero, uint32_t end, uint8_t value);
+  /**
+   * \param [in] buffer A buffer.
+   * \returns The bytes of the buffer.
+   */
+  std::vector<uint8_t> GetBytes (const Buffer &buffer);
+public:
+  virtual void DoRun (void);
+  BufferZeroAreaTest ();
+};
+
+BufferZeroAreaTest::BufferZeroAreaTest ()
+  : TestCase ("Check that AddAtEnd keeps the zero areas virtual")
+{
+}
+
+Buffer
+BufferZeroAreaTest::Create (uint32_t start, uint32_t zero, uint32_t end, uint8_t value)
+{
+  Buffer buffer (zero);
+  buffer.AddAtStart (start);
+  buffer.Begin ().WriteU8 (value, start);
+  buffer.AddAtEnd (end);
+  Buffer::Iterator i = buffer.End ();
+  i.Prev (end);
+  i.WriteU8 (value, end);
+  return buffer;
+}
+
+std::vector<uint8_t>
+BufferZeroAreaTest::GetBytes (const Buffer &buffer)
+{
+  std::vector<uint8_t> bytes (buffer.GetSize () + 1);
+  bytes.resize (buffer.CopyData (&bytes[0], buffer.GetSize ()));
+  return bytes;
+}
+
+void
+BufferZeroAreaTest::DoRun (void)
+{
+  // start, zero and end sizes of the first and second buffers
+  const uint32_t layouts[][6] = {
+    { 20, 1000, 0, 0, 500, 0 },     // adjacent zero areas
+    { 20, 1000, 0, 0, 500, 10 },
+    { 20, 1000, 4, 0, 500, 10 },    // the first zero area is larger
+    { 20, 100, 4, 8, 500, 10 },     // the second zero area is larger
+    { 0, 1000, 0, 8, 0, 10 },
+    { 20, 0, 0, 0, 0, 10 },         // no zero area
+  };
+  for (uint32_t l = 0; l < sizeof (layouts) / sizeof (layouts[0]); l++)
+    {
+      const uint32_t *s = layouts[l];
+      bool adjacent = s[2] == 0 && s[3] == 0 && s[4] > 0;
+      uint32_t zero = adjacent ? s[1] + s[4] : std::max (s[1], s[4]);
+      // shared: the first buffer shares its data with a copy or with
+      // a larger buffer
+      for (uint32_t shared = 0; shared < 3; shared++)
+        {
+          Buffer a = Create (s[0], s[1], s[2], 0x11);
+          Buffer copy = a;
+          if (shared == 2)
+            {
+              Buffer larger = Create (s[0], s[1], s[2] + 6, 0x11);
+              a = larger.CreateFragment (0, a.GetSize ());
+            }
+          if (shared == 0)
+            {
+              copy = Buffer ();
+            }
+          Buffer b = Create (s[3], s[4], s[5], 0x22);
+          std::vector<uint8_t> expected = GetBytes (a);
+          std::vector<uint8_t> tail = GetBytes (b);
+          expected.insert (expected.end (), tail.begin (), tail.end ());
+
+          a.AddAtEnd (b);
+          NS_TEST_ASSERT_MSG_EQ ((GetBytes (a) == expected), true,
+                                 "Wrong content with layout " << l << ", shared " << shared);
+          // a buffer of the same layout has the same serialized size
+          Buffer reference = Create (s[1] >= s[4] || adjacent ? s[0] : s[0] + s[1] + s[2] + s[3],
+                                     zero,
+                                     s[1] >= s[4] && !adjacent ? s[2] + s[3] + s[4] + s[5] : s[5],
+                                     0);
+          NS_TEST_ASSERT_MSG_EQ (a.GetSerializedSize (), reference.GetSerializedSize (),
+                                 "Zero area not kept with layout " << l << ", shared " << shared);
+        }
+    }
+
+  // a buffer appended to itself
+  Buffer a = Create (4, 100, 4, 0x33);
+  std::vector<uint8_t> expected = GetBytes (a);
+  std::vector<uint8_t> tail = expected;
+  expected.insert (expected.end (), tail.begin (), tail.end ());
+  a.AddAtEnd (a);
+  NS_TEST_ASSERT_MSG_EQ ((GetBytes (a) == expected), true, "Wrong content when appended to itself");
+
+  // several buffers appended at once: the zero areas of the first three
+  // are adjacent, and larger than that of the last one
+  std::vector<Buffer> buffers;
+  buffers.push_back (Create (0, 200, 0, 0x22));
+  buffers.push_back (Create (0, 20, 3, 0x33));
+  buffers.push_back (Create (4, 0, 0, 0x44));
+  buffers.push_back (Create (2, 300, 2, 0x55));
+  a = Create (5, 100, 0, 0x11);
+  expected = GetBytes (a);
+  for (uint32_t k = 0; k < buffers.size (); k++)
+    {
+      tail = GetBytes (buffers[k]);
+      expected.insert (expected.end (), tail.begin (), tail.end ());
+    }
+  a.AddAtEnd (buffers);
+  NS_TEST_ASSERT_MSG_EQ ((GetBytes (a) == expected), true, "Wrong content when appending several buffers");
+  Buffer reference = Create (5, 320, 311, 0);
+  NS_TEST_ASSERT_MSG_EQ (a.GetSerializedSize (), reference.GetSerializedSize (),
+                         "Zero areas not kept when appending several buffers");
+}
+//-----------------------------------------------------------------------------
 class BufferTestSuite : public TestSuite
 {
 public:
@@ -371,6 +500,7 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferZeroAreaTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite;
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/core-config.h"
+#include "ns3/data-cache.h"
+#include "ns3/buffer.h"
+#include "ns3/test.h"
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/callback.h"
+#include <utility>
+#include <vector>
+#endif /* HAVE_PTHREAD_H */
+
+using namespace ns3;
+
+class DataCacheTestCase : public TestCase
+{
+public:
+  DataCacheTestCase ();
+  virtual void DoRun (void);
+};
+
+DataCacheTestCase::DataCacheTestCase ()
+  : TestCase ("Check the free lists and the depot of a DataCache")
+{
+}
+
+void
+DataCacheTestCase::DoRun (void)
+{
+  DataCache cache (4, 2);
+  NS_TEST_ASSERT_MSG_EQ ((cache.Get (10) == 0), true, "The cache should be empty");
+
+  uint8_t *a = new uint8_t [100];
+  NS_TEST_ASSERT_MSG_EQ (cache.Put (a, 100), true, "Block not kept");
+  uint8_t *small = new uint8_t [50];
+  NS_TEST_ASSERT_MSG_EQ (cache.Put (small, 50), false, "A smaller block should not be kept");
+  delete [] small;
+  NS_TEST_ASSERT_MSG_EQ ((cache.Get (80) == a), true, "The cached block should be recycled");
+  delete [] a;
+
+  // the fifth block moves the two oldest ones to the depot, the seventh
+  // one finds the depot full
+  uint8_t *blocks[7];
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      blocks[i] = new uint8_t [100];
+      NS_TEST_ASSERT_MSG_EQ (cache.Put (blocks[i], 100), true, "Block " << i << " not kept");
+    }
+  for (uint32_t i = 6; i >= 4; i--)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((cache.Get (100) == blocks[i]), true, "Wrong block " << i);
+      delete [] blocks[i];
+    }
+  NS_TEST_ASSERT_MSG_EQ ((cache.Get (100) == blocks[1]), true, "The depot should refill the free list");
+  delete [] blocks[1];
+  // blocks[0] is too small, and deallocated by the cache
+  NS_TEST_ASSERT_MSG_EQ ((cache.Get (200) == 0), true, "No block is large enough");
+
+  DataCache::Stats stats = cache.GetStats ();
+  NS_TEST_ASSERT_MSG_EQ (stats.requests, 7, "Wrong number of requests");
+  NS_TEST_ASSERT_MSG_EQ (stats.hits, 5, "Wrong number of hits");
+  NS_TEST_ASSERT_MSG_EQ (stats.releases, 9, "Wrong number of releases");
+  NS_TEST_ASSERT_MSG_EQ (stats.discarded, 4, "Wrong number of discarded blocks");
+  NS_TEST_ASSERT_MSG_EQ (stats.toDepot, 2, "Wrong number of blocks moved to the depot");
+  NS_TEST_ASSERT_MSG_EQ (stats.fromDepot, 2, "Wrong number of blocks moved from the depot");
+  NS_TEST_ASSERT_MSG_EQ (stats.sizes[3], 1, "Wrong size distribution");
+  NS_TEST_ASSERT_MSG_EQ (stats.sizes[6], 5, "Wrong size distribution");
+  NS_TEST_ASSERT_MSG_EQ (stats.sizes[7], 1, "Wrong size distribution");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.GetHitRate (), 5.0 / 7, 1e-9, "Wrong hit rate");
+}
+
+#ifdef HAVE_PTHREAD_H
+class DataCacheThreadsTestCase : public TestCase
+{
+public:
+  DataCacheThreadsTestCase ();
+  virtual void DoRun (void);
+  /**
+   * Create and destroy buffers, and check that their content is
+   * not overwritten by the other threads.
+   * \param [in] context The test case, and the value written in the buffers.
+   */
+  static void Work (std::pair<DataCacheThreadsTestCase *, uint8_t> context);
+
+  bool m_corrupted;  //!< Whether a thread found a corrupted buffer
+};
+
+DataCacheThreadsTestCase::DataCacheThreadsTestCase ()
+  : TestCase ("Check that threads can create buffers concurrently")
+{
+}
+
+void
+DataCacheThreadsTestCase::Work (std::pair<DataCacheThreadsTestCase *, uint8_t> context)
+{
+  uint8_t value = context.second;
+  std::vector<Buffer> buffers;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      Buffer buffer;
+      buffer.AddAtStart (64 + i % 512);
+      Buffer::Iterator it = buffer.Begin ();
+      it.WriteU8 (value, buffer.GetSize ());
+      buffers.push_back (buffer);
+      if (buffers.size () == 100)
+        {
+          for (std::vector<Buffer>::const_iterator j = buffers.begin (); j != buffers.end (); ++j)
+            {
+              Buffer::Iterator k = j->Begin ();
+              for (uint32_t l = 0; l < j->GetSize (); l++)
+                {
+                  if (k.ReadU8 () != value)
+                    {
+                      context.first->m_corrupted = true;
+                    }
+                }
+            }
+          buffers.clear ();
+        }
+    }
+}
+
+void
+DataCacheThreadsTestCase::DoRun (void)
+{
+  m_corrupted = false;
+  DataCache::Stats before = Buffer::GetCacheStats ();
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint8_t i = 1; i <= 4; i++)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&DataCacheThreadsTestCase::Work, std::make_pair (this, i))));
+    }
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Start ();
+    }
+  for (uint32_t i = 0; i < threads.size (); i++)
+    {
+      threads[i]->Join ();
+    }
+  DataCache::Stats after = Buffer::GetCacheStats ();
+  NS_TEST_ASSERT_MSG_EQ (m_corrupted, false, "A buffer was shared by two threads");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (after.requests - before.requests, 4 * 20000, "Requests not counted");
+  NS_TEST_ASSERT_MSG_GT (after.hits - before.hits, 0, "The free lists should be used");
+  // the free lists of the exited threads went to the depot
+  NS_TEST_ASSERT_MSG_GT (after.toDepot - before.toDepot, 0, "The depot should be used");
+}
+#endif /* HAVE_PTHREAD_H */
+
+static class DataCacheTestSuite : public TestSuite
+{
+public:
+  DataCacheTestSuite ()
+    : TestSuite ("data-cache", UNIT)
+  {
+    AddTestCase (new DataCacheTestCase (), TestCase::QUICK);
+#ifdef HAVE_PTHREAD_H
+    AddTestCase (new DataCacheThreadsTestCase (), TestCase::QUICK);
+#endif /* HAVE_PTHREAD_H */
+  }
+} g_dataCacheTestSuite;
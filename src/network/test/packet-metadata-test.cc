@@ -20,6 +20,7 @@
 #include <cstdarg>
 #include <iostream>
 #include <sstream>
+#include <vector>
 #include "ns3/test.h"
 #include "ns3/header.h"
 #include "ns3/trailer.h"
@@ -252,17 +253,51 @@ HistoryTrailer<N>::Deserialize (Buffer::Iterator start)
 
 class PacketMetadataTest : public TestCase {
 public:
-  PacketMetadataTest ();
+  /**
+   * Constructor.
+   * \param compact Whether to check the compact representation.
+   */
+  PacketMetadataTest (bool compact);
   virtual ~PacketMetadataTest ();
   void CheckHistory (Ptr<Packet> p, const char *file, int line, uint32_t n, ...);
   virtual void DoRun (void);
+protected:
+  /**
+   * Constructor.
+   * \param name The name of the test case.
+   * \param compact Whether to check the compact representation.
+   */
+  PacketMetadataTest (std::string name, bool compact);
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
 private:
   Ptr<Packet> DoAddHeader (Ptr<Packet> p);
+  bool m_compact;
 };
 
-PacketMetadataTest::PacketMetadataTest ()
-  : TestCase ("Packet metadata")
+PacketMetadataTest::PacketMetadataTest (bool compact)
+  : TestCase (compact ? "Packet metadata, compact representation" : "Packet metadata"),
+    m_compact (compact)
+{
+}
+
+PacketMetadataTest::PacketMetadataTest (std::string name, bool compact)
+  : TestCase (name),
+    m_compact (compact)
+{
+}
+
+void
+PacketMetadataTest::DoSetup (void)
+{
+  PacketMetadata::Enable ();
+  PacketMetadata::SetCompact (m_compact);
+}
+
+void
+PacketMetadataTest::DoTeardown (void)
 {
+  PacketMetadata::SetCompact (false);
 }
 
 PacketMetadataTest::~PacketMetadataTest ()
@@ -398,7 +433,6 @@ PacketMetadataTest::DoAddHeader (Ptr<Packet> p)
 void
 PacketMetadataTest::DoRun (void)
 {
-  PacketMetadata::Enable ();
 
   Ptr<Packet> p = Create<Packet> (0);
   Ptr<Packet> p1 = Create<Packet> (0);
@@ -822,6 +856,72 @@ PacketMetadataTest::DoRun (void)
   delete [] buf;
   NS_TEST_EXPECT_MSG_EQ (msg, std::string ("hello world"), "Could not find original data in received packet");
 }
+
+/**
+ * Check that the packets share the nodes of the compact representation,
+ * and that they can be combined with the default one.
+ */
+class PacketMetadataCompactTest : public PacketMetadataTest {
+public:
+  PacketMetadataCompactTest ();
+  virtual void DoRun (void);
+};
+
+PacketMetadataCompactTest::PacketMetadataCompactTest ()
+  : PacketMetadataTest ("Sharing of the compact packet metadata", true)
+{
+}
+
+void
+PacketMetadataCompactTest::DoRun (void)
+{
+  uint32_t nNodes = PacketMetadata::GetNCompactNodes ();
+  {
+    std::vector<Ptr<Packet> > packets;
+    for (uint32_t i = 0; i < 100; i++)
+      {
+        Ptr<Packet> p = Create<Packet> (100);
+        ADD_HEADER (p, 10);
+        ADD_HEADER (p, 20);
+        packets.push_back (p);
+      }
+    NS_TEST_EXPECT_MSG_EQ (PacketMetadata::GetNCompactNodes () - nNodes, 3,
+                           "The packets should share their metadata");
+    CHECK_HISTORY (packets[99], 3, 20, 10, 100);
+    REM_HEADER (packets[0], 20);
+    CHECK_HISTORY (packets[0], 2, 10, 100);
+    NS_TEST_EXPECT_MSG_EQ (PacketMetadata::GetNCompactNodes () - nNodes, 3,
+                           "Removing a header should not create nodes");
+
+    Ptr<Packet> p = packets[1]->CreateFragment (0, 70);
+    CHECK_HISTORY (p, 3, 20, 10, 40);
+    Ptr<Packet> p2 = packets[1]->CreateFragment (70, 60);
+    CHECK_HISTORY (p2, 1, 60);
+    p->AddAtEnd (p2);
+    CHECK_HISTORY (p, 3, 20, 10, 100);
+    ADD_TRAILER (p, 4);
+    CHECK_HISTORY (p, 4, 20, 10, 100, 4);
+    REM_TRAILER (p, 4);
+    REM_HEADER (p, 20);
+    REM_HEADER (p, 10);
+    CHECK_HISTORY (p, 1, 100);
+
+    // metadata created before the compact representation was selected
+    PacketMetadata::SetCompact (false);
+    Ptr<Packet> other = Create<Packet> (10);
+    ADD_HEADER (other, 1);
+    PacketMetadata::SetCompact (true);
+    Ptr<Packet> compact = packets[2]->Copy ();
+    compact->AddAtEnd (other);
+    CHECK_HISTORY (compact, 5, 20, 10, 100, 1, 10);
+    other->AddAtEnd (packets[2]);
+    CHECK_HISTORY (other, 5, 1, 10, 20, 10, 100);
+    other->RemoveAtStart (15);
+    CHECK_HISTORY (other, 3, 16, 10, 100);
+  }
+  NS_TEST_EXPECT_MSG_EQ (PacketMetadata::GetNCompactNodes (), nNodes,
+                         "The nodes should be deleted with the packets");
+}
 //-----------------------------------------------------------------------------
 class PacketMetadataTestSuite : public TestSuite
 {
@@ -832,7 +932,9 @@ public:
 PacketMetadataTestSuite::PacketMetadataTestSuite ()
   : TestSuite ("packet-metadata", UNIT)
 {
-  AddTestCase (new PacketMetadataTest, TestCase::QUICK);
+  AddTestCase (new PacketMetadataTest (false), TestCase::QUICK);
+  AddTestCase (new PacketMetadataTest (true), TestCase::QUICK);
+  AddTestCase (new PacketMetadataCompactTest, TestCase::QUICK);
 }
 
 PacketMetadataTestSuite g_packetMetadataTest;
@@ -727,6 +727,17 @@ PacketTagListTest::DoRun (void)
     NS_TEST_EXPECT_MSG_EQ (ref.Peek (t10), false, "missing tag");
   }
 
+  { // Order
+    std::cout << GetName () << "check the tags are kept in order"
+              << std::endl;
+    ATestTagBase * tags[] = { &t1, &t2, &t3, &t4, &t5, &t6, &t7 };
+    NS_TEST_ASSERT_MSG_EQ (ref.GetNTags (), (uint32_t)tagLast, "number of tags");
+    for (int i = 0; i < tagLast; ++i) {
+      NS_TEST_EXPECT_MSG_EQ (ref.GetTags ()[i].tid, tags[i]->GetInstanceTypeId (),
+                             "tag " << i + 1);
+    }
+  }
+
   { // Copy ctor, assignment
     std::cout << GetName () << "check copy and assignment" << std::endl;
     { PacketTagList ptl (ref);
@@ -847,6 +858,138 @@ PacketTagListTest::DoRun (void)
     
 }
 
+//-----------------------------------------------------------------------------
+class PacketSlicesTest : public TestCase
+{
+public:
+  PacketSlicesTest ();
+private:
+  void DoRun (void);
+  /**
+   * \param [in] p A packet.
+   * \returns The bytes of the packet.
+   */
+  std::string GetBytes (Ptr<const Packet> p);
+  /**
+   * \returns The number of buffers of 2048 bytes or more created so far.
+   */
+  uint64_t GetLargeBuffers (void);
+};
+
+PacketSlicesTest::PacketSlicesTest ()
+  : TestCase ("Check that fragmentation and reassembly do not copy the payload")
+{
+}
+
+std::string
+PacketSlicesTest::GetBytes (Ptr<const Packet> p)
+{
+  std::string bytes (p->GetSize () + 1, '\0');
+  bytes.resize (p->CopyData (reinterpret_cast<uint8_t *> (&bytes[0]), p->GetSize ()));
+  return bytes;
+}
+
+uint64_t
+PacketSlicesTest::GetLargeBuffers (void)
+{
+  DataCache::Stats stats = Buffer::GetCacheStats ();
+  uint64_t n = 0;
+  for (uint32_t i = 11; i < DataCache::SIZE_BUCKETS; i++)
+    {
+      n += stats.sizes[i];
+    }
+  return n;
+}
+
+void
+PacketSlicesTest::DoRun (void)
+{
+  const uint32_t nFragments = 4;
+  const uint32_t fragmentSize = 3000;
+  std::string payload (nFragments * fragmentSize, '\0');
+  for (uint32_t i = 0; i < payload.size (); i++)
+    {
+      payload[i] = static_cast<char> (i % 251);
+    }
+  Ptr<Packet> p = Create<Packet> (reinterpret_cast<const uint8_t *> (payload.data ()), payload.size ());
+
+  // The first fragment shares the head of the buffer of the packet, so
+  // that a header can be added in place, but a trailer can not.
+  std::vector<Ptr<Packet> > fragments;
+  fragments.push_back (p->CreateFragment (0, fragmentSize));
+  fragments[0]->AddHeader (ATestHeader<10> ());
+  fragments[0]->AddTrailer (ATestTrailer<4> ());
+  uint64_t large = GetLargeBuffers ();
+  for (uint32_t i = 1; i < nFragments; i++)
+    {
+      Ptr<Packet> fragment = p->CreateFragment (i * fragmentSize, fragmentSize);
+      fragment->AddHeader (ATestHeader<10> ());
+      fragment->AddTrailer (ATestTrailer<4> ());
+      fragments.push_back (fragment);
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetLargeBuffers (), large, "The payload was copied by the fragmentation");
+  for (uint32_t i = 0; i < nFragments; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (fragments[i]->GetSize (), (fragmentSize + 14), "Wrong size of fragment " << i);
+      std::string expected = std::string (10, 10) + payload.substr (i * fragmentSize, fragmentSize)
+        + std::string (4, 4);
+      NS_TEST_EXPECT_MSG_EQ ((GetBytes (fragments[i]) == expected), true, "Wrong content of fragment " << i);
+    }
+
+  // remove the header and trailer of each fragment, and reassemble them
+  for (uint32_t i = 0; i < nFragments; i++)
+    {
+      ATestHeader<10> header;
+      fragments[i]->RemoveHeader (header);
+      NS_TEST_EXPECT_MSG_EQ (header.m_error, false, "Wrong header of fragment " << i);
+      ATestTrailer<4> trailer;
+      fragments[i]->RemoveTrailer (trailer);
+      NS_TEST_EXPECT_MSG_EQ (trailer.m_error, false, "Wrong trailer of fragment " << i);
+    }
+  large = GetLargeBuffers ();
+  Ptr<Packet> reassembled = Create<Packet> ();
+  for (uint32_t i = 0; i < nFragments; i++)
+    {
+      reassembled->AddAtEnd (fragments[i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetLargeBuffers (), large, "The fragments were copied by the reassembly");
+  NS_TEST_EXPECT_MSG_EQ (reassembled->GetSize (), payload.size (), "Wrong size of the reassembled packet");
+  NS_TEST_EXPECT_MSG_EQ ((GetBytes (reassembled) == payload), true, "Wrong content of the reassembled packet");
+
+  // a fragment across the slices
+  Ptr<Packet> middle = reassembled->CreateFragment (fragmentSize / 2, 2 * fragmentSize);
+  NS_TEST_EXPECT_MSG_EQ ((GetBytes (middle) == payload.substr (fragmentSize / 2, 2 * fragmentSize)), true,
+                         "Wrong content of a fragment across the slices");
+
+  // removal and padding across the slices
+  Ptr<Packet> trimmed = reassembled->Copy ();
+  trimmed->RemoveAtStart (fragmentSize + 5);
+  trimmed->RemoveAtEnd (fragmentSize + 7);
+  trimmed->AddPaddingAtEnd (3);
+  std::string expected = payload.substr (fragmentSize + 5, payload.size () - 2 * fragmentSize - 12)
+    + std::string (3, '\0');
+  NS_TEST_EXPECT_MSG_EQ ((GetBytes (trimmed) == expected), true, "Wrong content after removal and padding");
+
+  // the slices are joined once, when a header is read
+  reassembled->AddHeader (ATestHeader<10> ());
+  large = GetLargeBuffers ();
+  ATestHeader<10> header;
+  reassembled->PeekHeader (header);
+  NS_TEST_EXPECT_MSG_EQ (header.m_error, false, "Wrong header of the reassembled packet");
+  NS_TEST_EXPECT_MSG_GT (GetLargeBuffers (), large, "The slices were not joined");
+  large = GetLargeBuffers ();
+  reassembled->RemoveHeader (header);
+  NS_TEST_EXPECT_MSG_EQ (GetLargeBuffers (), large, "The slices were joined twice");
+  NS_TEST_EXPECT_MSG_EQ ((GetBytes (reassembled) == payload), true, "Wrong content after the join");
+
+  // serialization of a packet with slices
+  Ptr<Packet> q = p->CreateFragment (100, 5000);
+  q->AddHeader (ATestHeader<10> ());
+  std::vector<uint8_t> serialized (q->GetSerializedSize ());
+  NS_TEST_ASSERT_MSG_EQ (q->Serialize (&serialized[0], serialized.size ()), 1, "Serialization failed");
+  Ptr<Packet> r = Create<Packet> (&serialized[0], serialized.size (), true);
+  NS_TEST_EXPECT_MSG_EQ ((GetBytes (r) == GetBytes (q)), true, "Wrong content after deserialization");
+}
 //-----------------------------------------------------------------------------
 class PacketTestSuite : public TestSuite
 {
@@ -859,6 +1002,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketSlicesTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite;
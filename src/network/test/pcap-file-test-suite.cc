@@ -21,10 +21,16 @@
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <fstream>
 
 #include "ns3/log.h"
 #include "ns3/test.h"
 #include "ns3/pcap-file.h"
+#include "ns3/pcap-writer.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
 
 using namespace ns3;
 
@@ -1121,6 +1127,159 @@ DiffTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+// ===========================================================================
+// Test case to make sure that the buffered PcapWriter writes the same
+// records as the PcapFile, and well formed pcapng and gzip files
+// ===========================================================================
+class PcapWriterTestCase : public TestCase
+{
+public:
+  PcapWriterTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Read a whole file.
+   * \param filename The name of the file.
+   * \returns The bytes of the file.
+   */
+  std::string ReadFile (std::string filename);
+  /**
+   * \brief Read a 32 bit little endian value.
+   * \param data The bytes.
+   * \param offset The offset of the value.
+   * \returns The value.
+   */
+  uint32_t ReadU32 (const std::string &data, uint32_t offset);
+};
+
+PcapWriterTestCase::PcapWriterTestCase ()
+  : TestCase ("Check that PcapWriter writes the records in pcap, pcapng and gzip files")
+{
+}
+
+std::string
+PcapWriterTestCase::ReadFile (std::string filename)
+{
+  std::ifstream f (filename.c_str (), std::ios::in | std::ios::binary);
+  std::ostringstream oss;
+  oss << f.rdbuf ();
+  return oss.str ();
+}
+
+uint32_t
+PcapWriterTestCase::ReadU32 (const std::string &data, uint32_t offset)
+{
+  uint32_t value = 0;
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      value |= static_cast<uint32_t> (static_cast<uint8_t> (data[offset + i])) << (8 * i);
+    }
+  return value;
+}
+
+void
+PcapWriterTestCase::DoRun (void)
+{
+  const uint32_t snapLen = 100;
+  const uint32_t nRecords = 2000;
+  uint8_t data[200];
+  for (uint32_t i = 0; i < sizeof (data); ++i)
+    {
+      data[i] = i;
+    }
+
+  //
+  // Write the same records with a PcapFile, and with an asynchronous
+  // PcapWriter whose small blocks are handed over to its thread many times.
+  // Some records are longer than the snap length.
+  //
+  std::string syncFilename = CreateTempDirFilename ("pcap-writer-sync.pcap");
+  std::string asyncFilename = CreateTempDirFilename ("pcap-writer-async.pcap");
+  PcapFile f;
+  f.Open (syncFilename, std::ios::out);
+  f.Init (1, snapLen);
+  PcapWriter w (PcapWriter::PCAP, PcapWriter::NONE, 4096, true);
+  w.Open (asyncFilename);
+  NS_TEST_ASSERT_MSG_EQ (w.Fail (), false, "Open (" << asyncFilename << ") returns error");
+  w.Init (1, snapLen, 0, false);
+  for (uint32_t i = 0; i < nRecords; ++i)
+    {
+      f.Write (i / 1000, i % 1000, data, i % sizeof (data));
+      w.Write (i / 1000, i % 1000, data, i % sizeof (data));
+    }
+  f.Close ();
+  w.Close ();
+  NS_TEST_ASSERT_MSG_EQ (w.Fail (), false, "Close () returns error");
+
+  std::string syncData = ReadFile (syncFilename);
+  NS_TEST_ASSERT_MSG_EQ ((syncData.size () > nRecords * 16), true, "The records were not written");
+  NS_TEST_EXPECT_MSG_EQ ((ReadFile (asyncFilename) == syncData), true,
+                         "The PcapWriter and the PcapFile write different files");
+
+  //
+  // Check the blocks of a pcapng file: a section header block, an
+  // interface description block, and an enhanced packet block per record.
+  //
+  std::string ngFilename = CreateTempDirFilename ("pcap-writer.pcapng");
+  PcapWriter ng (PcapWriter::PCAPNG, PcapWriter::NONE, 64, false);
+  ng.Open (ngFilename);
+  ng.Init (1, snapLen, 0, true);
+  ng.Write (1, 5, data, 3);
+  ng.Write (2, 7, data, 150);
+  ng.Close ();
+  std::string ngData = ReadFile (ngFilename);
+  NS_TEST_ASSERT_MSG_EQ (ngData.size (), (28 + 32 + (32 + 4) + (32 + 100)), "Unexpected size of the pcapng file");
+  NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, 0), 0x0a0d0d0a, "Unexpected section header block type");
+  NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, 8), 0x1a2b3c4d, "Unexpected byte order magic");
+  NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, 28), 1, "Unexpected interface description block type");
+  NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, 40), snapLen, "Unexpected snap length");
+  uint32_t offset = 60;
+  uint32_t records = 0;
+  while (offset < ngData.size ())
+    {
+      uint32_t length = ReadU32 (ngData, offset + 4);
+      NS_TEST_ASSERT_MSG_EQ (ReadU32 (ngData, offset), 6, "Unexpected enhanced packet block type");
+      NS_TEST_ASSERT_MSG_EQ (ReadU32 (ngData, offset + length - 4), length, "Unexpected block trailer");
+      NS_TEST_EXPECT_MSG_EQ (length % 4, 0, "Unpadded block");
+      uint64_t ts = (static_cast<uint64_t> (ReadU32 (ngData, offset + 12)) << 32) | ReadU32 (ngData, offset + 16);
+      NS_TEST_EXPECT_MSG_EQ (ts, ((records + 1) * 1000000000ULL + 5 + 2 * records), "Unexpected timestamp");
+      NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, offset + 20), (records == 0 ? 3 : snapLen), "Unexpected captured length");
+      NS_TEST_EXPECT_MSG_EQ (ReadU32 (ngData, offset + 24), (records == 0 ? 3 : 150), "Unexpected original length");
+      offset += length;
+      records++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (records, 2, "Unexpected number of records");
+
+#ifdef HAVE_ZLIB
+  //
+  // Check that a compressed file holds the bytes of the uncompressed one.
+  //
+  std::string gzFilename = CreateTempDirFilename ("pcap-writer.pcap.gz");
+  PcapWriter gz (PcapWriter::PCAP, PcapWriter::GZIP, 4096, true);
+  gz.Open (gzFilename);
+  gz.Init (1, snapLen, 0, false);
+  for (uint32_t i = 0; i < nRecords; ++i)
+    {
+      gz.Write (i / 1000, i % 1000, data, i % sizeof (data));
+    }
+  gz.Close ();
+  NS_TEST_ASSERT_MSG_EQ (gz.Fail (), false, "Close () returns error");
+  NS_TEST_EXPECT_MSG_EQ ((ReadFile (gzFilename).size () < syncData.size ()), true, "The file was not compressed");
+  gzFile in = gzopen (gzFilename.c_str (), "rb");
+  NS_TEST_ASSERT_MSG_EQ ((in != 0), true, "gzopen (" << gzFilename << ") returns error");
+  std::string gzData;
+  char chunk[4096];
+  int n;
+  while ((n = gzread (in, chunk, sizeof (chunk))) > 0)
+    {
+      gzData.append (chunk, n);
+    }
+  gzclose (in);
+  NS_TEST_EXPECT_MSG_EQ ((gzData == syncData), true, "The decompressed file differs from the PcapFile");
+#endif /* HAVE_ZLIB */
+}
+
 class PcapFileTestSuite : public TestSuite
 {
 public:
@@ -1138,6 +1297,7 @@ PcapFileTestSuite::PcapFileTestSuite ()
   AddTestCase (new RecordHeaderTestCase, TestCase::QUICK);
   AddTestCase (new ReadFileTestCase, TestCase::QUICK);
   AddTestCase (new DiffTestCase, TestCase::QUICK);
+  AddTestCase (new PcapWriterTestCase, TestCase::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite;
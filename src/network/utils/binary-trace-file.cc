@@ -0,0 +1,484 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "binary-trace-file.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BinaryTraceFile");
+
+namespace {
+
+const char FILE_MAGIC[8] = { 'n', 's', '3', 't', 'r', 'a', 'c', 'e' };   //!< Magic of the file header
+const char FOOTER_MAGIC[8] = { 'n', 's', '3', 'i', 'n', 'd', 'e', 'x' }; //!< Magic of the file trailer
+const uint16_t VERSION_MAJOR = 1;   //!< Major version of the file format
+const uint16_t VERSION_MINOR = 0;   //!< Minor version of the file format
+const uint32_t FILE_HEADER_SIZE = 16;  //!< Size of the file header
+const uint32_t TRAILER_SIZE = 16;      //!< Size of the file trailer
+
+/**
+ * \brief Write a value in little endian order.
+ * \param buffer The buffer.
+ * \param value The value.
+ * \param size The size of the value, in bytes.
+ */
+void
+WriteLittleEndian (uint8_t *buffer, uint64_t value, uint32_t size)
+{
+  for (uint32_t i = 0; i < size; i++)
+    {
+      buffer[i] = (value >> (8 * i)) & 0xff;
+    }
+}
+
+/**
+ * \brief Read a value in little endian order.
+ * \param buffer The buffer.
+ * \param size The size of the value, in bytes.
+ * \returns The value.
+ */
+uint64_t
+ReadLittleEndian (const uint8_t *buffer, uint32_t size)
+{
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      value |= static_cast<uint64_t> (buffer[i]) << (8 * i);
+    }
+  return value;
+}
+
+} // anonymous namespace
+
+BinaryTraceFile::TextBuffer::TextBuffer (BinaryTraceFile *file)
+  : m_file (file)
+{
+}
+
+BinaryTraceFile::TextBuffer::int_type
+BinaryTraceFile::TextBuffer::overflow (int_type c)
+{
+  if (traits_type::eq_int_type (c, traits_type::eof ()))
+    {
+      return traits_type::not_eof (c);
+    }
+  char ch = traits_type::to_char_type (c);
+  xsputn (&ch, 1);
+  return c;
+}
+
+std::streamsize
+BinaryTraceFile::TextBuffer::xsputn (const char *s, std::streamsize n)
+{
+  for (std::streamsize i = 0; i < n; i++)
+    {
+      if (s[i] == '\n')
+        {
+          m_file->WriteText (Simulator::Now (), m_line);
+          m_line.clear ();
+        }
+      else
+        {
+          m_line.push_back (s[i]);
+        }
+    }
+  return n;
+}
+
+BinaryTraceFile::BinaryTraceFile ()
+  : m_file (),
+    m_writing (false),
+    m_resolution (Time::GetResolution ()),
+    m_indexInterval (INDEX_INTERVAL_DEFAULT),
+    m_nRecords (0),
+    m_footer (0),
+    m_textBuffer (this),
+    m_text (&m_textBuffer)
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::RegisterStream (&m_file);
+}
+
+BinaryTraceFile::~BinaryTraceFile ()
+{
+  NS_LOG_FUNCTION (this);
+  FatalImpl::UnregisterStream (&m_file);
+  Close ();
+}
+
+bool
+BinaryTraceFile::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_file.fail ();
+}
+
+void
+BinaryTraceFile::Open (std::string const &filename, std::ios::openmode mode)
+{
+  NS_LOG_FUNCTION (this << filename << mode);
+  NS_ASSERT ((mode & std::ios::app) == 0);
+  NS_ASSERT (!m_file.fail ());
+
+  m_writing = (mode & std::ios::out) != 0;
+  m_nRecords = 0;
+  m_footer = 0;
+  m_ids.clear ();
+  m_contexts.clear ();
+  m_index.clear ();
+  m_file.open (filename.c_str (), mode | std::ios::binary);
+  if (m_file.fail ())
+    {
+      return;
+    }
+
+  uint8_t header[FILE_HEADER_SIZE];
+  if (m_writing)
+    {
+      m_resolution = Time::GetResolution ();
+      std::memset (header, 0, sizeof (header));
+      std::memcpy (header, FILE_MAGIC, sizeof (FILE_MAGIC));
+      WriteLittleEndian (header + 8, VERSION_MAJOR, 2);
+      WriteLittleEndian (header + 10, VERSION_MINOR, 2);
+      header[12] = m_resolution;
+      m_file.write ((const char *)header, sizeof (header));
+      return;
+    }
+
+  m_file.read ((char *)header, sizeof (header));
+  if (m_file.fail () ||
+      std::memcmp (header, FILE_MAGIC, sizeof (FILE_MAGIC)) != 0 ||
+      ReadLittleEndian (header + 8, 2) != VERSION_MAJOR)
+    {
+      m_file.setstate (std::ios::failbit);
+      return;
+    }
+  m_resolution = static_cast<enum Time::Unit> (header[12]);
+  ReadFooter ();
+}
+
+void
+BinaryTraceFile::ReadFooter (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_file.seekg (0, std::ios::end);
+  uint64_t end = m_file.tellg ();
+  if (end < FILE_HEADER_SIZE + TRAILER_SIZE)
+    {
+      m_file.clear ();
+      return;
+    }
+  uint8_t trailer[TRAILER_SIZE];
+  m_file.seekg (end - TRAILER_SIZE, std::ios::beg);
+  m_file.read ((char *)trailer, sizeof (trailer));
+  if (m_file.fail () ||
+      std::memcmp (trailer + 8, FOOTER_MAGIC, sizeof (FOOTER_MAGIC)) != 0)
+    {
+      // not closed: the contexts are read along with the records
+      m_file.clear ();
+      return;
+    }
+  m_footer = ReadLittleEndian (trailer, 8);
+  m_file.seekg (m_footer, std::ios::beg);
+  struct RecordHeader header;
+  while (ReadRecordHeader (header))
+    {
+      m_data.resize (header.size);
+      if (header.size != 0)
+        {
+          m_file.read ((char *)&m_data[0], header.size);
+        }
+      if (header.type == STRING)
+        {
+          if (header.context >= m_contexts.size ())
+            {
+              m_contexts.resize (header.context + 1);
+            }
+          m_contexts[header.context].assign (m_data.begin (), m_data.end ());
+        }
+      else if (header.type == INDEX)
+        {
+          for (uint32_t i = 0; i + 16 <= header.size; i += 16)
+            {
+              int64_t time = ReadLittleEndian (&m_data[i], 8);
+              uint64_t offset = ReadLittleEndian (&m_data[i + 8], 8);
+              m_index.push_back (std::make_pair (time, offset));
+            }
+          break;
+        }
+    }
+  m_file.clear ();
+}
+
+void
+BinaryTraceFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+  if (m_writing && !m_file.fail ())
+    {
+      // The contexts and the index, then the offset of the contexts
+      uint64_t footer = m_file.tellp ();
+      struct RecordHeader header;
+      for (uint32_t i = 0; i < m_contexts.size (); i++)
+        {
+          header.type = STRING;
+          header.context = i;
+          header.time = 0;
+          header.size = m_contexts[i].size ();
+          WriteRecord (header, (const uint8_t *)m_contexts[i].data ());
+        }
+      m_data.resize (m_index.size () * 16);
+      for (uint32_t i = 0; i < m_index.size (); i++)
+        {
+          WriteLittleEndian (&m_data[i * 16], m_index[i].first, 8);
+          WriteLittleEndian (&m_data[i * 16 + 8], m_index[i].second, 8);
+        }
+      header.type = INDEX;
+      header.context = NO_CONTEXT;
+      header.time = 0;
+      header.size = m_data.size ();
+      WriteRecord (header, m_data.empty () ? 0 : &m_data[0]);
+      uint8_t trailer[TRAILER_SIZE];
+      WriteLittleEndian (trailer, footer, 8);
+      std::memcpy (trailer + 8, FOOTER_MAGIC, sizeof (FOOTER_MAGIC));
+      m_file.write ((const char *)trailer, sizeof (trailer));
+    }
+  m_file.close ();
+}
+
+void
+BinaryTraceFile::SetIndexInterval (uint32_t interval)
+{
+  NS_LOG_FUNCTION (this << interval);
+  NS_ASSERT (interval > 0);
+  m_indexInterval = interval;
+}
+
+uint32_t
+BinaryTraceFile::Intern (std::string const &context)
+{
+  std::map<std::string, uint32_t>::const_iterator i = m_ids.find (context);
+  if (i != m_ids.end ())
+    {
+      return i->second;
+    }
+  uint32_t id = m_contexts.size ();
+  m_ids.insert (std::make_pair (context, id));
+  m_contexts.push_back (context);
+  struct RecordHeader header;
+  header.type = STRING;
+  header.context = id;
+  header.time = 0;
+  header.size = context.size ();
+  WriteRecord (header, (const uint8_t *)context.data ());
+  return id;
+}
+
+void
+BinaryTraceFile::Write (enum RecordType type, Time t, std::string const &context, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << type << t << context << p);
+  struct RecordHeader header;
+  header.type = type;
+  header.context = Intern (context);
+  header.time = t.GetTimeStep ();
+  header.size = p->GetSerializedSize ();
+  m_data.resize (header.size);
+  p->Serialize (&m_data[0], header.size);
+  WriteRecord (header, &m_data[0]);
+}
+
+void
+BinaryTraceFile::Write (enum RecordType type, Time t, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << type << t << p);
+  struct RecordHeader header;
+  header.type = type;
+  header.context = NO_CONTEXT;
+  header.time = t.GetTimeStep ();
+  header.size = p->GetSerializedSize ();
+  m_data.resize (header.size);
+  p->Serialize (&m_data[0], header.size);
+  WriteRecord (header, &m_data[0]);
+}
+
+void
+BinaryTraceFile::WriteText (Time t, std::string const &text)
+{
+  NS_LOG_FUNCTION (this << t << text);
+  struct RecordHeader header;
+  header.type = TEXT;
+  header.context = NO_CONTEXT;
+  header.time = t.GetTimeStep ();
+  header.size = text.size ();
+  WriteRecord (header, (const uint8_t *)text.data ());
+}
+
+std::ostream *
+BinaryTraceFile::GetTextStream (void)
+{
+  NS_LOG_FUNCTION (this);
+  return &m_text;
+}
+
+void
+BinaryTraceFile::WriteRecord (const struct RecordHeader &header, const uint8_t *data)
+{
+  NS_ASSERT (m_writing);
+  if (header.type != STRING && header.type != INDEX)
+    {
+      if (m_nRecords % m_indexInterval == 0)
+        {
+          m_index.push_back (std::make_pair (header.time, static_cast<uint64_t> (m_file.tellp ())));
+        }
+      m_nRecords++;
+    }
+  uint8_t buffer[RECORD_HEADER_SIZE];
+  buffer[0] = header.type;
+  buffer[1] = 0;
+  buffer[2] = 0;
+  buffer[3] = 0;
+  WriteLittleEndian (buffer + 4, header.context, 4);
+  WriteLittleEndian (buffer + 8, header.time, 8);
+  WriteLittleEndian (buffer + 16, header.size, 4);
+  m_file.write ((const char *)buffer, sizeof (buffer));
+  if (header.size != 0)
+    {
+      m_file.write ((const char *)data, header.size);
+    }
+}
+
+bool
+BinaryTraceFile::ReadRecordHeader (struct RecordHeader &header)
+{
+  uint8_t buffer[RECORD_HEADER_SIZE];
+  m_file.read ((char *)buffer, sizeof (buffer));
+  if (m_file.gcount () != RECORD_HEADER_SIZE)
+    {
+      return false;
+    }
+  header.type = buffer[0];
+  header.context = ReadLittleEndian (buffer + 4, 4);
+  header.time = ReadLittleEndian (buffer + 8, 8);
+  header.size = ReadLittleEndian (buffer + 16, 4);
+  return true;
+}
+
+enum Time::Unit
+BinaryTraceFile::GetResolution (void) const
+{
+  return m_resolution;
+}
+
+uint32_t
+BinaryTraceFile::GetNIndexEntries (void) const
+{
+  return m_index.size ();
+}
+
+uint64_t
+BinaryTraceFile::Convert (std::ostream &os, Time start, Time stop)
+{
+  NS_LOG_FUNCTION (this << start << stop);
+  NS_ASSERT (!m_writing);
+
+  //
+  // Start from the last index entry before the window, whose records
+  // were all written after it.
+  //
+  uint64_t offset = FILE_HEADER_SIZE;
+  std::vector<std::pair<int64_t, uint64_t> >::const_iterator i =
+    std::lower_bound (m_index.begin (), m_index.end (),
+                      std::make_pair (start.GetTimeStep (), static_cast<uint64_t> (0)));
+  if (i != m_index.begin ())
+    {
+      offset = (i - 1)->second;
+    }
+  m_file.clear ();
+  m_file.seekg (offset, std::ios::beg);
+
+  uint64_t nRecords = 0;
+  struct RecordHeader header;
+  while (ReadRecordHeader (header))
+    {
+      if (header.type == INDEX)
+        {
+          break;
+        }
+      m_data.resize (header.size);
+      if (header.type == STRING)
+        {
+          if (header.size != 0)
+            {
+              m_file.read ((char *)&m_data[0], header.size);
+            }
+          if (header.context >= m_contexts.size ())
+            {
+              m_contexts.resize (header.context + 1);
+            }
+          m_contexts[header.context].assign (m_data.begin (), m_data.end ());
+          continue;
+        }
+      nRecords++;
+      if (header.time > stop.GetTimeStep ())
+        {
+          break;
+        }
+      if (header.time < start.GetTimeStep ())
+        {
+          m_file.seekg (header.size, std::ios::cur);
+          continue;
+        }
+      if (header.size != 0)
+        {
+          m_file.read ((char *)&m_data[0], header.size);
+        }
+      if (m_file.fail ())
+        {
+          break;
+        }
+      if (header.type == TEXT)
+        {
+          os << std::string (m_data.begin (), m_data.end ()) << std::endl;
+          continue;
+        }
+      os << header.type << " " << TimeStep (header.time).GetSeconds () << " ";
+      if (header.context != NO_CONTEXT)
+        {
+          NS_ABORT_MSG_UNLESS (header.context < m_contexts.size (), "Unknown context " << header.context);
+          os << m_contexts[header.context] << " ";
+        }
+      Ptr<Packet> p = Create<Packet> (&m_data[0], header.size, true);
+      os << *p << std::endl;
+    }
+  m_file.clear ();
+  return nRecords;
+}
+
+} // namespace ns3
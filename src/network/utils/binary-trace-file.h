@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <map>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+class Packet;
+
+/**
+ * \brief A binary replacement for the text of the ascii traces.
+ *
+ * The ascii trace sinks of AsciiTraceHelper format a line of text for
+ * each event, and print the whole packet in it.  When they write to an
+ * OutputStreamWrapper created by AsciiTraceHelper::CreateBinaryFileStream,
+ * they store a record in a BinaryTraceFile instead, which the
+ * convert-binary-trace program, or Convert, turns back into the same
+ * lines of text, on demand.
+ *
+ * The file is a sequence of records, each of which starts with a
+ * fixed-width header: the type of the record, the id of its context,
+ * its time, in time steps of the resolution of the simulation, and the
+ * size of the data which follows.  The data of an event is the
+ * serialized packet (see Packet::Serialize); the contexts, like the
+ * "/NodeList/3/DeviceList/1/..." paths, are stored once, in a string
+ * record, and then referred to by their id.  The text written to the
+ * stream of the wrapper, by the other trace sinks, is stored in text
+ * records, one per line.
+ *
+ * Every SetIndexInterval records, the time and offset of the record
+ * are added to a time index, which Close writes at the end of the file,
+ * along with the contexts, so that Convert can extract a window of time
+ * without reading the records which come before it.  A file which was
+ * not closed can still be converted, from its start.
+ *
+ * The multi-byte fields are written in little endian order.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+public:
+  /** The types of records */
+  enum RecordType
+  {
+    ENQUEUE = '+',   //!< A packet was enqueued
+    DEQUEUE = '-',   //!< A packet was dequeued
+    DROP = 'd',      //!< A packet was dropped
+    RECEIVE = 'r',   //!< A packet was received
+    TEXT = 't',      //!< A line of text
+    STRING = 's',    //!< The definition of a context
+    INDEX = 'i'      //!< The time index
+  };
+
+  static const uint32_t INDEX_INTERVAL_DEFAULT = 4096; /**< Default number of records between two index entries */
+
+  BinaryTraceFile ();
+  ~BinaryTraceFile ();
+
+  /**
+   * \return true if the 'fail' bit is set in the underlying fstream, false otherwise.
+   */
+  bool Fail (void) const;
+
+  /**
+   * \brief Create a new file, or open an existing file.
+   *
+   * A file opened for writing starts with a header which records the
+   * resolution of the simulation.  A file opened for reading is checked,
+   * and its index and contexts are read if it was closed.
+   *
+   * \param filename The name of the file.
+   * \param mode std::ios::out to write the file, or std::ios::in to read it.
+   */
+  void Open (std::string const &filename, std::ios::openmode mode);
+
+  /**
+   * \brief Close the file.
+   *
+   * A file opened for writing is completed with its contexts and its index.
+   */
+  void Close (void);
+
+  /**
+   * \param interval The number of records between two entries of the index.
+   */
+  void SetIndexInterval (uint32_t interval);
+
+  /**
+   * \brief Write a packet event.
+   *
+   * \param type The type of the event: ENQUEUE, DEQUEUE, DROP or RECEIVE.
+   * \param t The time of the event.
+   * \param context The context of the event.
+   * \param p The packet.
+   */
+  void Write (enum RecordType type, Time t, std::string const &context, Ptr<const Packet> p);
+  /**
+   * \brief Write a packet event, without context.
+   *
+   * \param type The type of the event: ENQUEUE, DEQUEUE, DROP or RECEIVE.
+   * \param t The time of the event.
+   * \param p The packet.
+   */
+  void Write (enum RecordType type, Time t, Ptr<const Packet> p);
+  /**
+   * \brief Write a line of text.
+   *
+   * \param t The time of the line.
+   * \param text The text, without the end of line.
+   */
+  void WriteText (Time t, std::string const &text);
+  /**
+   * \returns A stream whose lines are written as text records, at the
+   *          current simulation time.
+   */
+  std::ostream *GetTextStream (void);
+
+  /**
+   * \returns The resolution of the times of the file, which must be that
+   *          of the simulation for Convert to give the right times.
+   */
+  enum Time::Unit GetResolution (void) const;
+  /**
+   * \returns The number of entries of the index, zero if the file was
+   *          not closed.
+   */
+  uint32_t GetNIndexEntries (void) const;
+
+  /**
+   * \brief Convert the records of a window of time to the text of the
+   * ascii traces.
+   *
+   * \param os The stream to print the text to.
+   * \param start The time of the first records to print.
+   * \param stop The time after which no record is printed.
+   * \returns The number of records read from the file, including
+   *          those outside the window.
+   */
+  uint64_t Convert (std::ostream &os, Time start = Time (0), Time stop = Time::Max ());
+
+private:
+  /**
+   * \brief The header of a record, as stored in the file.
+   */
+  struct RecordHeader
+  {
+    uint8_t type;     //!< The RecordType
+    uint32_t context; //!< The id of the context, NO_CONTEXT, or that of a STRING
+    int64_t time;     //!< The time, in time steps
+    uint32_t size;    //!< The size of the data which follows
+  };
+  /** The size of a record header in the file. */
+  static const uint32_t RECORD_HEADER_SIZE = 20;
+  /** The context id of the events without context. */
+  static const uint32_t NO_CONTEXT = 0xffffffff;
+
+  /** A stream buffer which turns each line into a text record. */
+  class TextBuffer : public std::streambuf
+  {
+  public:
+    /**
+     * Constructor.
+     * \param file The file of the records.
+     */
+    TextBuffer (BinaryTraceFile *file);
+  protected:
+    /**
+     * \param c The next character.
+     * \returns The character.
+     */
+    virtual int_type overflow (int_type c);
+    /**
+     * \param s The next characters.
+     * \param n The number of characters.
+     * \returns The number of characters.
+     */
+    virtual std::streamsize xsputn (const char *s, std::streamsize n);
+  private:
+    BinaryTraceFile *m_file; //!< The file of the records
+    std::string m_line;      //!< The current line
+  };
+
+  /**
+   * \param context A context.
+   * \returns The id of the context, written in a new STRING record if
+   *          it was not yet interned.
+   */
+  uint32_t Intern (std::string const &context);
+  /**
+   * \brief Write a record.
+   * \param header The header of the record.
+   * \param data The data of the record.
+   */
+  void WriteRecord (const struct RecordHeader &header, const uint8_t *data);
+  /**
+   * \brief Read the header of the next record.
+   * \param header The header.
+   * \returns false at the end of the file.
+   */
+  bool ReadRecordHeader (struct RecordHeader &header);
+  /**
+   * \brief Read the contexts and the index of a closed file.
+   */
+  void ReadFooter (void);
+
+  /**
+   * Copy constructor: not implemented.
+   * \param o The file.
+   */
+  BinaryTraceFile (const BinaryTraceFile &o);
+  /**
+   * Assignment: not implemented.
+   * \param o The file.
+   * \returns This file.
+   */
+  BinaryTraceFile & operator = (const BinaryTraceFile &o);
+
+  std::fstream m_file;                        //!< The file
+  bool m_writing;                             //!< Whether the file is written
+  enum Time::Unit m_resolution;               //!< The resolution of the times
+  uint32_t m_indexInterval;                   //!< Number of records between index entries
+  uint64_t m_nRecords;                        //!< Number of records written
+  uint64_t m_footer;                          //!< Offset of the contexts and index, or 0
+  std::map<std::string, uint32_t> m_ids;      //!< The ids of the contexts written
+  std::vector<std::string> m_contexts;        //!< The contexts, by id
+  std::vector<std::pair<int64_t, uint64_t> > m_index; //!< The times and offsets of the index
+  std::vector<uint8_t> m_data;                //!< The data of the current record
+  TextBuffer m_textBuffer;                    //!< The buffer of the text stream
+  std::ostream m_text;                        //!< The text stream
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
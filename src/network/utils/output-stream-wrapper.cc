@@ -46,6 +46,13 @@ OutputStreamWrapper::OutputStreamWrapper (std::ostream* os)
   NS_ABORT_MSG_UNLESS (m_ostream->good (), "Output stream is not vaild for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper (Ptr<BinaryTraceFile> file)
+  : m_ostream (file->GetTextStream ()), m_destroyable (false), m_binary (file)
+{
+  NS_LOG_FUNCTION (this << file);
+  FatalImpl::RegisterStream (m_ostream);
+}
+
 OutputStreamWrapper::~OutputStreamWrapper ()
 {
   NS_LOG_FUNCTION (this);
@@ -61,4 +68,11 @@ OutputStreamWrapper::GetStream (void)
   return m_ostream;
 }
 
+Ptr<BinaryTraceFile>
+OutputStreamWrapper::GetBinaryFile (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_binary;
+}
+
 } // namespace ns3
@@ -23,6 +23,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
+#include "binary-trace-file.h"
 
 namespace ns3 {
 
@@ -66,6 +67,10 @@ namespace ns3 {
  *
  * This class uses a basic ns-3 reference counting base class but is not 
  * an ns3::Object with attributes, TypeId, or aggregation.
+ *
+ * A wrapper can also encapsulate a BinaryTraceFile, in which case the
+ * default ascii trace sinks of AsciiTraceHelper store binary records in
+ * it, and the text written to the stream is stored as text records.
  */
 class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
 {
@@ -81,6 +86,11 @@ public:
    * \param os output stream
    */
   OutputStreamWrapper (std::ostream* os);
+  /**
+   * Constructor
+   * \param file binary trace file, whose text stream is encapsulated
+   */
+  OutputStreamWrapper (Ptr<BinaryTraceFile> file);
   ~OutputStreamWrapper ();
 
   /**
@@ -92,9 +102,15 @@ public:
    */
   std::ostream *GetStream (void);
 
+  /**
+   * \returns the binary trace file set in the wrapper, or zero
+   */
+  Ptr<BinaryTraceFile> GetBinaryFile (void) const;
+
 private:
   std::ostream *m_ostream; //!< The output stream
   bool m_destroyable; //!< Can be destroyed
+  Ptr<BinaryTraceFile> m_binary; //!< The binary trace file, or zero
 };
 
 } // namespace ns3
@@ -17,8 +17,10 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/assert.h"
 #include "ns3/boolean.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
 #include "ns3/buffer.h"
 #include "ns3/header.h"
 #include "pcap-file-wrapper.h"
@@ -46,12 +48,42 @@ PcapFileWrapper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&PcapFileWrapper::m_nanosecMode),
                    MakeBooleanChecker())
+    .AddAttribute ("Asynchronous",
+                   "Whether the records of a file opened for writing are written "
+                   "by a background thread, one per file, in blocks of BlockSize bytes.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PcapFileWrapper::m_async),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BlockSize",
+                   "The number of bytes of records buffered before they are written, "
+                   "if the file is written asynchronously, in pcapng or compressed.",
+                   UintegerValue (1048576),
+                   MakeUintegerAccessor (&PcapFileWrapper::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Format",
+                   "The format of the files opened for writing.",
+                   EnumValue (PcapWriter::PCAP),
+                   MakeEnumAccessor (&PcapFileWrapper::m_format),
+                   MakeEnumChecker (PcapWriter::PCAP, "Pcap",
+                                    PcapWriter::PCAPNG, "PcapNg"))
+    .AddAttribute ("Compression",
+                   "The compression of the files opened for writing: gzip is only "
+                   "available if zlib was found at configure time.",
+                   EnumValue (PcapWriter::NONE),
+                   MakeEnumAccessor (&PcapFileWrapper::m_compression),
+#ifdef HAVE_ZLIB
+                   MakeEnumChecker (PcapWriter::NONE, "None",
+                                    PcapWriter::GZIP, "Gzip"))
+#else /* HAVE_ZLIB */
+                   MakeEnumChecker (PcapWriter::NONE, "None"))
+#endif /* HAVE_ZLIB */
   ;
   return tid;
 }
 
 
 PcapFileWrapper::PcapFileWrapper ()
+  : m_writer (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -60,12 +92,17 @@ PcapFileWrapper::~PcapFileWrapper ()
 {
   NS_LOG_FUNCTION (this);
   Close ();   
+  delete m_writer;
 }
 
 bool 
 PcapFileWrapper::Fail (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->Fail ();
+    }
   return m_file.Fail ();
 }
 
@@ -73,6 +110,10 @@ bool
 PcapFileWrapper::Eof (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return false;
+    }
   return m_file.Eof ();
 }
 void 
@@ -86,6 +127,10 @@ void
 PcapFileWrapper::Close (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      m_writer->Close ();
+    }
   m_file.Close ();
 }
 
@@ -93,6 +138,23 @@ void
 PcapFileWrapper::Open (std::string const &filename, std::ios::openmode mode)
 {
   NS_LOG_FUNCTION (this << filename << mode);
+  if (m_writer != 0)
+    {
+      m_writer->Close ();
+      delete m_writer;
+      m_writer = 0;
+    }
+  //
+  // Files which are created for writing can be written by a PcapWriter.
+  // Files which are read, or appended to, are always handled by the PcapFile.
+  //
+  bool create = (mode & std::ios::out) && !(mode & (std::ios::in | std::ios::app));
+  if (create && (m_async || m_format != PcapWriter::PCAP || m_compression != PcapWriter::NONE))
+    {
+      m_writer = new PcapWriter (m_format, m_compression, m_blockSize, m_async);
+      m_writer->Open (filename);
+      return;
+    }
   m_file.Open (filename, mode);
 }
 
@@ -105,33 +167,52 @@ PcapFileWrapper::Init (uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrec
   // a snaplen, we use the one provided.
   //
   NS_LOG_FUNCTION (this << dataLinkType << snapLen << tzCorrection);
-  if (snapLen != std::numeric_limits<uint32_t>::max ())
+  if (snapLen == std::numeric_limits<uint32_t>::max ())
+    {
+      snapLen = m_snapLen;
+    }
+  if (m_writer != 0)
+    {
+      m_writer->Init (dataLinkType, snapLen, tzCorrection, m_nanosecMode);
+    }
+  else
     {
       m_file.Init (dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
     } 
+}
+
+void
+PcapFileWrapper::SplitTime (Time t, uint32_t &sec, uint32_t &frac)
+{
+  bool nanosecMode = m_writer != 0 ? m_writer->IsNanoSecMode () : m_file.IsNanoSecMode ();
+  if (nanosecMode)
+    {
+      uint64_t current = t.GetNanoSeconds ();
+      sec  = current / 1000000000;
+      frac = current % 1000000000;
+    }
   else
     {
-      m_file.Init (dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
-    } 
+      uint64_t current = t.GetMicroSeconds ();
+      sec  = current / 1000000;
+      frac = current % 1000000;
+    }
 }
 
 void
 PcapFileWrapper::Write (Time t, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << p);
-  if (m_file.IsNanoSecMode())
+  uint32_t s;
+  uint32_t frac;
+  SplitTime (t, s, frac);
+  if (m_writer != 0)
     {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, p);
+      m_writer->Write (s, frac, p);
     }
   else
     {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, p);
+      m_file.Write (s, frac, p);
     }
 }
 
@@ -139,19 +220,16 @@ void
 PcapFileWrapper::Write (Time t, const Header &header, Ptr<const Packet> p)
 {
   NS_LOG_FUNCTION (this << t << &header << p);
-  if (m_file.IsNanoSecMode())
+  uint32_t s;
+  uint32_t frac;
+  SplitTime (t, s, frac);
+  if (m_writer != 0)
     {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, header, p);
+      m_writer->Write (s, frac, header, p);
     }
   else
     {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, header, p);
+      m_file.Write (s, frac, header, p);
     }
 }
 
@@ -159,19 +237,16 @@ void
 PcapFileWrapper::Write (Time t, uint8_t const *buffer, uint32_t length)
 {
   NS_LOG_FUNCTION (this << t << &buffer << length);
-  if (m_file.IsNanoSecMode())
+  uint32_t s;
+  uint32_t frac;
+  SplitTime (t, s, frac);
+  if (m_writer != 0)
     {
-      uint64_t current = t.GetNanoSeconds ();
-      uint64_t s       = current / 1000000000;
-      uint64_t ns      = current % 1000000000;
-      m_file.Write (s, ns, buffer, length);
+      m_writer->Write (s, frac, buffer, length);
     }
   else
     {
-      uint64_t current = t.GetMicroSeconds ();
-      uint64_t s       = current / 1000000;
-      uint64_t us      = current % 1000000;
-      m_file.Write (s, us, buffer, length);
+      m_file.Write (s, frac, buffer, length);
     }
 }
 
@@ -184,6 +259,8 @@ PcapFileWrapper::Read (Time &t)
   uint32_t origLen;
   uint32_t readLen;
 
+  NS_ASSERT_MSG (m_writer == 0, "PcapFileWrapper::Read(): file opened for writing");
+
   uint32_t maxBytes=65536;
   uint8_t  datbuf[maxBytes];
 
@@ -211,6 +288,10 @@ uint32_t
 PcapFileWrapper::GetMagic (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetMagic ();
+    }
   return m_file.GetMagic ();
 }
 
@@ -218,6 +299,10 @@ uint16_t
 PcapFileWrapper::GetVersionMajor (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetVersionMajor ();
+    }
   return m_file.GetVersionMajor ();
 }
 
@@ -225,6 +310,10 @@ uint16_t
 PcapFileWrapper::GetVersionMinor (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetVersionMinor ();
+    }
   return m_file.GetVersionMinor ();
 }
 
@@ -232,6 +321,10 @@ int32_t
 PcapFileWrapper::GetTimeZoneOffset (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetTimeZoneOffset ();
+    }
   return m_file.GetTimeZoneOffset ();
 }
 
@@ -239,6 +332,10 @@ uint32_t
 PcapFileWrapper::GetSigFigs (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return 0;
+    }
   return m_file.GetSigFigs ();
 }
 
@@ -246,6 +343,10 @@ uint32_t
 PcapFileWrapper::GetSnapLen (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetSnapLen ();
+    }
   return m_file.GetSnapLen ();
 }
 
@@ -253,6 +354,10 @@ uint32_t
 PcapFileWrapper::GetDataLinkType (void)
 {
   NS_LOG_FUNCTION (this);
+  if (m_writer != 0)
+    {
+      return m_writer->GetDataLinkType ();
+    }
   return m_file.GetDataLinkType ();
 }
 
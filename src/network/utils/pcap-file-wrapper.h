@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "pcap-writer.h"
 
 namespace ns3 {
 
@@ -35,6 +36,12 @@ namespace ns3 {
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * Files opened for writing can be written by a PcapWriter rather than by
+ * a PcapFile, which buffers the records in large blocks, optionally writes
+ * them from a background thread, and can write pcapng or gzip compressed
+ * files; see the Asynchronous, BlockSize, Format and Compression attributes.
+ * Such files are only complete once closed, or once the wrapper is destroyed.
  */
 class PcapFileWrapper : public Object
 {
@@ -221,7 +228,20 @@ public:
   uint32_t GetDataLinkType (void);
 
 private:
+  /**
+   * \brief Split a timestamp in seconds and microseconds or nanoseconds.
+   * \param [in] t The timestamp.
+   * \param [out] sec The seconds.
+   * \param [out] frac The microseconds or nanoseconds.
+   */
+  void SplitTime (Time t, uint32_t &sec, uint32_t &frac);
+
   PcapFile m_file; //!< Pcap file
+  PcapWriter *m_writer; //!< Buffered writer of the file, or 0 to use m_file
+  bool     m_async; //!< Write the blocks from a background thread
+  uint32_t m_blockSize; //!< Size of the blocks of the buffered writer
+  enum PcapWriter::Format m_format; //!< File format
+  enum PcapWriter::Compression m_compression; //!< Compression of the file
   uint32_t m_snapLen; //!< max length of saved packets
   bool     m_nanosecMode; //!< Timestamps in nanosecond mode
 };
@@ -0,0 +1,555 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "ns3/core-config.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+#include "ns3/packet.h"
+#include "ns3/header.h"
+#include "ns3/buffer.h"
+#include "pcap-writer.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#include "ns3/system-thread.h"
+#include "ns3/callback.h"
+#endif /* HAVE_PTHREAD_H */
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif /* HAVE_ZLIB */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PcapWriter");
+
+namespace {
+
+const uint32_t PCAP_MAGIC = 0xa1b2c3d4;     //!< Magic number of the pcap files
+const uint32_t PCAP_NS_MAGIC = 0xa1b23c4d;  //!< Magic number of the nanosecond pcap files
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1a2b3c4d; //!< Byte order magic of the pcapng files
+
+const uint32_t PCAPNG_SECTION_HEADER_BLOCK = 0x0a0d0d0a;  //!< Section header block type
+const uint32_t PCAPNG_INTERFACE_DESCRIPTION_BLOCK = 1;    //!< Interface description block type
+const uint32_t PCAPNG_ENHANCED_PACKET_BLOCK = 6;          //!< Enhanced packet block type
+const uint16_t PCAPNG_OPT_ENDOFOPT = 0;                   //!< End of options
+const uint16_t PCAPNG_OPT_IF_TSRESOL = 9;                 //!< Timestamp resolution option
+
+} // anonymous namespace
+
+#ifdef HAVE_PTHREAD_H
+/** The writer thread, and what it shares with the simulation. */
+struct PcapWriter::Sync
+{
+  pthread_mutex_t mutex;     //!< Protects the pending blocks, the free blocks and the flags
+  pthread_cond_t ready;      //!< Signaled when a block is pending, or on close
+  pthread_cond_t done;       //!< Signaled when a block has been written
+  Ptr<SystemThread> thread;  //!< The writer thread
+};
+#else /* HAVE_PTHREAD_H */
+struct PcapWriter::Sync
+{
+};
+#endif /* HAVE_PTHREAD_H */
+
+PcapWriter::PcapWriter (enum Format format, enum Compression compression,
+                        uint32_t blockSize, bool async)
+  : m_format (format),
+    m_compression (compression),
+    m_blockSize (std::max<uint32_t> (blockSize, 1)),
+    m_async (async),
+    m_failed (false),
+    m_nanosecMode (false),
+    m_zone (0),
+    m_snapLen (0),
+    m_dataLinkType (0),
+    m_file (0),
+    m_block (new std::vector<uint8_t> ()),
+    m_recordStart (0),
+    m_writing (false),
+    m_closing (false),
+    m_sync (0)
+{
+  NS_LOG_FUNCTION (this << format << compression << blockSize << async);
+#ifndef HAVE_ZLIB
+  if (m_compression == GZIP)
+    {
+      NS_FATAL_ERROR ("PcapWriter::PcapWriter(): gzip compression requires zlib");
+    }
+#endif /* HAVE_ZLIB */
+  m_block->reserve (m_blockSize);
+}
+
+PcapWriter::~PcapWriter ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+  delete m_block;
+  for (std::vector<std::vector<uint8_t> *>::iterator i = m_free.begin (); i != m_free.end (); ++i)
+    {
+      delete *i;
+    }
+}
+
+bool
+PcapWriter::Fail (void) const
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  if (m_sync != 0)
+    {
+      pthread_mutex_lock (&m_sync->mutex);
+      bool failed = m_failed;
+      pthread_mutex_unlock (&m_sync->mutex);
+      return failed;
+    }
+#endif /* HAVE_PTHREAD_H */
+  return m_failed;
+}
+
+void
+PcapWriter::Open (std::string const &filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  NS_ASSERT (m_file == 0);
+  m_failed = false;
+  if (m_compression == NONE)
+    {
+      m_file = std::fopen (filename.c_str (), "wb");
+    }
+#ifdef HAVE_ZLIB
+  else
+    {
+      m_file = gzopen (filename.c_str (), "wb");
+    }
+#endif /* HAVE_ZLIB */
+  if (m_file == 0)
+    {
+      m_failed = true;
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_async)
+    {
+      m_sync = new Sync;
+      pthread_mutex_init (&m_sync->mutex, 0);
+      pthread_cond_init (&m_sync->ready, 0);
+      pthread_cond_init (&m_sync->done, 0);
+      m_closing = false;
+      m_writing = false;
+      m_sync->thread = Create<SystemThread> (MakeCallback (&PcapWriter::Run, this));
+      m_sync->thread->Start ();
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+PcapWriter::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file == 0)
+    {
+      return;
+    }
+  HandOver ();
+#ifdef HAVE_PTHREAD_H
+  if (m_sync != 0)
+    {
+      pthread_mutex_lock (&m_sync->mutex);
+      m_closing = true;
+      pthread_cond_signal (&m_sync->ready);
+      pthread_mutex_unlock (&m_sync->mutex);
+      m_sync->thread->Join ();
+      m_sync->thread = 0;
+      pthread_cond_destroy (&m_sync->done);
+      pthread_cond_destroy (&m_sync->ready);
+      pthread_mutex_destroy (&m_sync->mutex);
+      delete m_sync;
+      m_sync = 0;
+    }
+#endif /* HAVE_PTHREAD_H */
+  if (m_compression == NONE)
+    {
+      if (std::fclose (static_cast<FILE *> (m_file)) != 0)
+        {
+          m_failed = true;
+        }
+    }
+#ifdef HAVE_ZLIB
+  else
+    {
+      if (gzclose (static_cast<gzFile> (m_file)) != Z_OK)
+        {
+          m_failed = true;
+        }
+    }
+#endif /* HAVE_ZLIB */
+  m_file = 0;
+}
+
+void
+PcapWriter::Flush (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_file == 0)
+    {
+      return;
+    }
+  HandOver ();
+#ifdef HAVE_PTHREAD_H
+  if (m_sync != 0)
+    {
+      pthread_mutex_lock (&m_sync->mutex);
+      while (!m_pending.empty () || m_writing)
+        {
+          pthread_cond_wait (&m_sync->done, &m_sync->mutex);
+        }
+      pthread_mutex_unlock (&m_sync->mutex);
+    }
+#endif /* HAVE_PTHREAD_H */
+  // The writer thread is idle until the next hand over.
+  if (m_compression == NONE)
+    {
+      std::fflush (static_cast<FILE *> (m_file));
+    }
+#ifdef HAVE_ZLIB
+  else
+    {
+      gzflush (static_cast<gzFile> (m_file), Z_SYNC_FLUSH);
+    }
+#endif /* HAVE_ZLIB */
+}
+
+void
+PcapWriter::Init (uint32_t dataLinkType, uint32_t snapLen,
+                  int32_t timeZoneCorrection, bool nanosecMode)
+{
+  NS_LOG_FUNCTION (this << dataLinkType << snapLen << timeZoneCorrection << nanosecMode);
+  m_dataLinkType = dataLinkType;
+  m_snapLen = snapLen;
+  m_zone = timeZoneCorrection;
+  m_nanosecMode = nanosecMode;
+
+  if (m_format == PCAP)
+    {
+      WriteU32 (GetMagic ());
+      WriteU16 (GetVersionMajor ());
+      WriteU16 (GetVersionMinor ());
+      WriteU32 (static_cast<uint32_t> (m_zone));
+      WriteU32 (0);
+      WriteU32 (m_snapLen);
+      WriteU32 (m_dataLinkType);
+      return;
+    }
+
+  // The section header block, of unspecified section length
+  WriteU32 (PCAPNG_SECTION_HEADER_BLOCK);
+  WriteU32 (28);
+  WriteU32 (PCAPNG_BYTE_ORDER_MAGIC);
+  WriteU16 (GetVersionMajor ());
+  WriteU16 (GetVersionMinor ());
+  WriteU32 (0xffffffff);
+  WriteU32 (0xffffffff);
+  WriteU32 (28);
+
+  // The interface description block, with the timestamp resolution
+  WriteU32 (PCAPNG_INTERFACE_DESCRIPTION_BLOCK);
+  WriteU32 (32);
+  WriteU16 (static_cast<uint16_t> (m_dataLinkType));
+  WriteU16 (0);
+  WriteU32 (m_snapLen);
+  WriteU16 (PCAPNG_OPT_IF_TSRESOL);
+  WriteU16 (1);
+  WriteU32 (m_nanosecMode ? 9 : 6);
+  WriteU16 (PCAPNG_OPT_ENDOFOPT);
+  WriteU16 (0);
+  WriteU32 (32);
+}
+
+void
+PcapWriter::Write (uint32_t tsSec, uint32_t tsFrac, uint8_t const *data, uint32_t totalLen)
+{
+  NS_LOG_FUNCTION (this << tsSec << tsFrac << &data << totalLen);
+  uint32_t inclLen = WriteRecordHeader (tsSec, tsFrac, totalLen);
+  if (inclLen != 0)
+    {
+      std::memcpy (Reserve (inclLen), data, inclLen);
+    }
+  WriteRecordTrailer (inclLen);
+}
+
+void
+PcapWriter::Write (uint32_t tsSec, uint32_t tsFrac, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << tsSec << tsFrac << p);
+  uint32_t inclLen = WriteRecordHeader (tsSec, tsFrac, p->GetSize ());
+  if (inclLen != 0)
+    {
+      p->CopyData (Reserve (inclLen), inclLen);
+    }
+  WriteRecordTrailer (inclLen);
+}
+
+void
+PcapWriter::Write (uint32_t tsSec, uint32_t tsFrac, const Header &header, Ptr<const Packet> p)
+{
+  NS_LOG_FUNCTION (this << tsSec << tsFrac << &header << p);
+  uint32_t headerSize = header.GetSerializedSize ();
+  uint32_t inclLen = WriteRecordHeader (tsSec, tsFrac, headerSize + p->GetSize ());
+  if (inclLen != 0)
+    {
+      uint8_t *data = Reserve (inclLen);
+      Buffer headerBuffer;
+      headerBuffer.AddAtStart (headerSize);
+      header.Serialize (headerBuffer.Begin ());
+      uint32_t toCopy = std::min (headerSize, inclLen);
+      headerBuffer.CopyData (data, toCopy);
+      p->CopyData (data + toCopy, inclLen - toCopy);
+    }
+  WriteRecordTrailer (inclLen);
+}
+
+bool
+PcapWriter::IsNanoSecMode (void) const
+{
+  return m_nanosecMode;
+}
+
+uint32_t
+PcapWriter::GetMagic (void) const
+{
+  if (m_format == PCAPNG)
+    {
+      return PCAPNG_BYTE_ORDER_MAGIC;
+    }
+  return m_nanosecMode ? PCAP_NS_MAGIC : PCAP_MAGIC;
+}
+
+uint16_t
+PcapWriter::GetVersionMajor (void) const
+{
+  return m_format == PCAP ? 2 : 1;
+}
+
+uint16_t
+PcapWriter::GetVersionMinor (void) const
+{
+  return m_format == PCAP ? 4 : 0;
+}
+
+int32_t
+PcapWriter::GetTimeZoneOffset (void) const
+{
+  return m_zone;
+}
+
+uint32_t
+PcapWriter::GetSnapLen (void) const
+{
+  return m_snapLen;
+}
+
+uint32_t
+PcapWriter::GetDataLinkType (void) const
+{
+  return m_dataLinkType;
+}
+
+uint32_t
+PcapWriter::WriteRecordHeader (uint32_t tsSec, uint32_t tsFrac, uint32_t totalLen)
+{
+  uint32_t inclLen = std::min (totalLen, m_snapLen);
+  m_recordStart = m_block->size ();
+  if (m_format == PCAP)
+    {
+      WriteU32 (tsSec);
+      WriteU32 (tsFrac);
+      WriteU32 (inclLen);
+      WriteU32 (totalLen);
+      return inclLen;
+    }
+  uint64_t ts = tsSec * static_cast<uint64_t> (m_nanosecMode ? 1000000000 : 1000000) + tsFrac;
+  WriteU32 (PCAPNG_ENHANCED_PACKET_BLOCK);
+  WriteU32 (0); // The block length, set by WriteRecordTrailer
+  WriteU32 (0); // The interface
+  WriteU32 (static_cast<uint32_t> (ts >> 32));
+  WriteU32 (static_cast<uint32_t> (ts));
+  WriteU32 (inclLen);
+  WriteU32 (totalLen);
+  return inclLen;
+}
+
+void
+PcapWriter::WriteRecordTrailer (uint32_t inclLen)
+{
+  if (m_format == PCAPNG)
+    {
+      uint32_t padding = (4 - inclLen % 4) % 4;
+      if (padding != 0)
+        {
+          std::memset (Reserve (padding), 0, padding);
+        }
+      uint32_t length = m_block->size () + 4 - m_recordStart;
+      WriteU32 (length);
+      uint8_t *start = &(*m_block)[m_recordStart + 4];
+      start[0] = length & 0xff;
+      start[1] = (length >> 8) & 0xff;
+      start[2] = (length >> 16) & 0xff;
+      start[3] = (length >> 24) & 0xff;
+    }
+  if (m_block->size () >= m_blockSize)
+    {
+      HandOver ();
+    }
+}
+
+uint8_t *
+PcapWriter::Reserve (uint32_t size)
+{
+  NS_ASSERT (size != 0);
+  uint32_t start = m_block->size ();
+  m_block->resize (start + size);
+  return &(*m_block)[start];
+}
+
+void
+PcapWriter::WriteU16 (uint16_t value)
+{
+  uint8_t *data = Reserve (2);
+  data[0] = value & 0xff;
+  data[1] = (value >> 8) & 0xff;
+}
+
+void
+PcapWriter::WriteU32 (uint32_t value)
+{
+  uint8_t *data = Reserve (4);
+  data[0] = value & 0xff;
+  data[1] = (value >> 8) & 0xff;
+  data[2] = (value >> 16) & 0xff;
+  data[3] = (value >> 24) & 0xff;
+}
+
+void
+PcapWriter::HandOver (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_block->empty () || m_file == 0)
+    {
+      return;
+    }
+#ifdef HAVE_PTHREAD_H
+  if (m_sync != 0)
+    {
+      pthread_mutex_lock (&m_sync->mutex);
+      while (m_pending.size () >= MAX_PENDING_BLOCKS)
+        {
+          pthread_cond_wait (&m_sync->done, &m_sync->mutex);
+        }
+      m_pending.push_back (m_block);
+      pthread_cond_signal (&m_sync->ready);
+      if (m_free.empty ())
+        {
+          m_block = 0;
+        }
+      else
+        {
+          m_block = m_free.back ();
+          m_free.pop_back ();
+        }
+      pthread_mutex_unlock (&m_sync->mutex);
+      if (m_block == 0)
+        {
+          m_block = new std::vector<uint8_t> ();
+          m_block->reserve (m_blockSize);
+        }
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  if (!WriteBlock (*m_block))
+    {
+      m_failed = true;
+    }
+  m_block->clear ();
+}
+
+bool
+PcapWriter::WriteBlock (const std::vector<uint8_t> &block)
+{
+  bool ok;
+  if (m_compression == NONE)
+    {
+      ok = std::fwrite (&block[0], 1, block.size (), static_cast<FILE *> (m_file)) == block.size ();
+    }
+#ifdef HAVE_ZLIB
+  else
+    {
+      ok = gzwrite (static_cast<gzFile> (m_file), &block[0], block.size ()) == static_cast<int> (block.size ());
+    }
+#else /* HAVE_ZLIB */
+  else
+    {
+      ok = false;
+    }
+#endif /* HAVE_ZLIB */
+  return ok;
+}
+
+void
+PcapWriter::Run (void)
+{
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_lock (&m_sync->mutex);
+  while (true)
+    {
+      while (m_pending.empty () && !m_closing)
+        {
+          pthread_cond_wait (&m_sync->ready, &m_sync->mutex);
+        }
+      if (m_pending.empty ())
+        {
+          break;
+        }
+      std::vector<uint8_t> *block = m_pending.front ();
+      m_pending.pop_front ();
+      m_writing = true;
+      bool failed = m_failed;
+      pthread_mutex_unlock (&m_sync->mutex);
+
+      if (!failed)
+        {
+          failed = !WriteBlock (*block);
+        }
+      block->clear ();
+
+      pthread_mutex_lock (&m_sync->mutex);
+      if (failed)
+        {
+          m_failed = true;
+        }
+      m_free.push_back (block);
+      m_writing = false;
+      pthread_cond_signal (&m_sync->done);
+    }
+  pthread_mutex_unlock (&m_sync->mutex);
+#endif /* HAVE_PTHREAD_H */
+}
+
+} // namespace ns3
@@ -20,6 +20,8 @@
 
 #include <ns3/object.h>
 #include <ns3/simulator.h>
+#include <ns3/event-batch.h>
+#include <ns3/make-event.h>
 #include <ns3/log.h>
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
@@ -272,6 +274,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
+  EventBatch batch;
   for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
@@ -360,20 +363,23 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 {
                   // the receiver has a NetDevice, so we expect that it is attached to a Node
                   uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  batch.Add (dstNode, delay,
+                             MakeEvent (&MultiModelSpectrumChannel::StartRx, this,
+                                        rxParams, *rxPhyIterator));
                 }
               else
                 {
                   // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
+                  batch.Add (Simulator::GetContext (), delay,
+                             MakeEvent (&MultiModelSpectrumChannel::StartRx, this,
+                                        rxParams, *rxPhyIterator));
                 }
             }
         }
 
     }
 
+  Simulator::ScheduleBatch (batch);
 }
 
 void
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/binary-trace-file.h"
+
+using namespace ns3;
+
+/*
+ * Print the text of the ascii traces stored in a binary trace file,
+ * created with AsciiTraceHelper::CreateBinaryFileStream.  This program
+ * is linked with all the modules, so that it can print all their headers.
+ *
+ *   convert-binary-trace --input=trace.btr --start=10 --stop=20 > trace.tr
+ */
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  double start = 0;
+  double stop = -1;
+
+  CommandLine cmd;
+  cmd.Usage ("Convert a binary trace file to the text of the ascii traces");
+  cmd.AddValue ("input", "the binary trace file", input);
+  cmd.AddValue ("output", "the text file, instead of the standard output", output);
+  cmd.AddValue ("start", "the time of the first events to print, in seconds", start);
+  cmd.AddValue ("stop", "the time after which no event is printed, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  if (input.empty ())
+    {
+      std::cerr << "Error-- the binary trace file must be specified " <<
+        "by command-line argument --input=(file name)" << std::endl;
+      exit (1);
+    }
+
+  Ptr<BinaryTraceFile> file = Create<BinaryTraceFile> ();
+  file->Open (input, std::ios::in);
+  if (file->Fail ())
+    {
+      std::cerr << "Error-- unable to read " << input << std::endl;
+      exit (1);
+    }
+  // The times of the file are time steps of the resolution of the simulation.
+  if (file->GetResolution () != Time::GetResolution ())
+    {
+      Time::SetResolution (file->GetResolution ());
+    }
+
+  Packet::EnablePrinting ();
+  std::ofstream os;
+  if (!output.empty ())
+    {
+      os.open (output.c_str ());
+      if (!os.is_open ())
+        {
+          std::cerr << "Error-- unable to write " << output << std::endl;
+          exit (1);
+        }
+    }
+  file->Convert (output.empty () ? std::cout : os, Seconds (start),
+                 stop < 0 ? Time::Max () : Seconds (stop));
+  file->Close ();
+
+  return 0;
+}